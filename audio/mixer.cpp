@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/config-manager.h"
 #include "common/util.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -496,8 +497,12 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	assert(mixer);
 	assert(stream);
 
-	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo);
+	// Get a rate converter instance of the configured quality
+	RateConverterQuality quality = kRateConverterQualityDefault;
+	if (ConfMan.hasKey("resampler_quality"))
+		quality = (RateConverterQuality)CLIP<int>(ConfMan.getInt("resampler_quality"), kRateConverterQualityDefault, kRateConverterQualitySincBest);
+
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo, quality);
 }
 
 Channel::~Channel() {
@@ -32,9 +32,18 @@
 #include "audio/rate.h"
 #include "audio/mixer.h"
 #include "common/frac.h"
+#include "common/math.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
+#if defined(__SSE2__) && !defined(OUTPUT_UNSIGNED_AUDIO)
+#define USE_SSE2_MIXING
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON__) || defined(__ARM_NEON)) && !defined(OUTPUT_UNSIGNED_AUDIO)
+#define USE_NEON_MIXING
+#include <arm_neon.h>
+#endif
+
 namespace Audio {
 
 
@@ -47,6 +56,112 @@ namespace Audio {
 #define INTERMEDIATE_BUFFER_SIZE 512
 
 
+#pragma mark -
+
+
+/**
+ * Scale the samples in src by the channel volumes and add them with
+ * saturation to the stereo output buffer. This is the inner loop shared
+ * by all rate converters.
+ *
+ * When stereo is set, src contains numFrames left/right sample pairs,
+ * otherwise numFrames mono samples. The result is identical to calling
+ * clampedAdd(obuf[i], (sample * vol) / Mixer::kMaxMixerVolume) for every
+ * output sample. On targets supporting SSE2 or NEON, eight (respectively
+ * four) samples are processed at once.
+ */
+template<bool stereo, bool reverseStereo>
+static void mixSamples(st_sample_t *obuf, const st_sample_t *src, st_size_t numFrames, st_volume_t vol_l, st_volume_t vol_r) {
+	// The vector code relies on the division by kMaxMixerVolume being a
+	// shift by 8, with the rounding towards zero done by hand.
+	assert(Audio::Mixer::kMaxMixerVolume == 256);
+
+#if defined(USE_SSE2_MIXING)
+	const __m128i vol = _mm_set_epi16(vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l);
+	const __m128i bias = _mm_set1_epi32(Audio::Mixer::kMaxMixerVolume - 1);
+
+	// Each iteration produces four stereo output frames
+	for (; numFrames >= 4; numFrames -= 4) {
+		__m128i in;
+		if (stereo) {
+			in = _mm_loadu_si128((const __m128i *)src);
+			src += 8;
+		} else {
+			in = _mm_loadl_epi64((const __m128i *)src);
+			in = _mm_unpacklo_epi16(in, in);
+			src += 4;
+		}
+
+		// Compute the 32 bit products and divide them by kMaxMixerVolume
+		const __m128i lo = _mm_mullo_epi16(in, vol);
+		const __m128i hi = _mm_mulhi_epi16(in, vol);
+		__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+		__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+		p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), bias)), 8);
+		p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), bias)), 8);
+		__m128i out = _mm_packs_epi32(p0, p1);
+
+		if (reverseStereo) {
+			out = _mm_shufflelo_epi16(out, _MM_SHUFFLE(2, 3, 0, 1));
+			out = _mm_shufflehi_epi16(out, _MM_SHUFFLE(2, 3, 0, 1));
+		}
+
+		_mm_storeu_si128((__m128i *)obuf, _mm_adds_epi16(_mm_loadu_si128((const __m128i *)obuf), out));
+		obuf += 8;
+	}
+#elif defined(USE_NEON_MIXING)
+	const int16 volArray[4] = { (int16)vol_l, (int16)vol_r, (int16)vol_l, (int16)vol_r };
+	const int16x4_t vol = vld1_s16(volArray);
+
+	// Each iteration produces two stereo output frames
+	for (; numFrames >= 2; numFrames -= 2) {
+		int16x4_t in;
+		if (stereo) {
+			in = vld1_s16(src);
+			src += 4;
+		} else {
+			in = vld1_lane_s16(src, vdup_n_s16(0), 0);
+			in = vld1_lane_s16(src + 1, in, 1);
+			in = vzip_s16(in, in).val[0];
+			src += 2;
+		}
+
+		// Compute the 32 bit products and divide them by kMaxMixerVolume.
+		// Adding 255 to negative products makes the shift round towards
+		// zero, like the division in the C code does.
+		int32x4_t p = vmull_s16(in, vol);
+		p = vaddq_s32(p, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(p, 31)), 24)));
+		int16x4_t out = vshrn_n_s32(p, 8);
+
+		if (reverseStereo)
+			out = vrev32_s16(out);
+
+		vst1_s16(obuf, vqadd_s16(vld1_s16(obuf), out));
+		obuf += 4;
+	}
+#endif
+
+	// Handle the remaining frames (or everything when no vector unit is
+	// available)
+	for (; numFrames > 0; --numFrames) {
+		st_sample_t out0, out1;
+		out0 = *src++;
+		out1 = (stereo ? *src++ : out0);
+
+		// output left channel
+		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+
+		// output right channel
+		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+
+		obuf += 2;
+	}
+}
+
+
+#pragma mark -
+
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -60,6 +175,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** resampled stereo output, before volume scaling and mixing */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** position of how far output is ahead of input */
 	/** Holds what would have been opos-ipos */
 	long opos;
@@ -109,37 +227,52 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	oend = obuf + osamp * 2;
 
 	while (obuf < oend) {
+		// Resample a chunk into the intermediate output buffer, which is
+		// then mixed into the output in one go
+		st_sample_t *tmp = outBuf;
+		st_sample_t *tmpEnd = outBuf + MIN<st_size_t>(oend - obuf, ARRAYSIZE(outBuf));
+		bool endOfInput = false;
+
+		while (tmp < tmpEnd) {
+
+			// read enough input samples so that opos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				opos--;
+				if (opos >= 0) {
+					inPtr += (stereo ? 2 : 1);
+				}
+			} while (opos >= 0);
+
+			if (endOfInput)
+				break;
 
-		// read enough input samples so that opos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
-			}
-			inLen -= (stereo ? 2 : 1);
-			opos--;
-			if (opos >= 0) {
-				inPtr += (stereo ? 2 : 1);
-			}
-		} while (opos >= 0);
-
-		st_sample_t out0, out1;
-		out0 = *inPtr++;
-		out1 = (stereo ? *inPtr++ : out0);
+			st_sample_t out0, out1;
+			out0 = *inPtr++;
+			out1 = (stereo ? *inPtr++ : out0);
 
-		// Increment output position
-		opos += opos_inc;
+			// Increment output position
+			opos += opos_inc;
 
-		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			*tmp++ = out0;
+			*tmp++ = out1;
+		}
 
-		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		const st_size_t numFrames = (tmp - outBuf) / 2;
+		mixSamples<true, reverseStereo>(obuf, outBuf, numFrames, vol_l, vol_r);
+		obuf += numFrames * 2;
 
-		obuf += 2;
+		if (endOfInput)
+			break;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -162,6 +295,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** resampled stereo output, before volume scaling and mixing */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** fractional position of the output stream in input stream unit */
 	frac_t opos;
 
@@ -218,47 +354,342 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	oend = obuf + osamp * 2;
 
 	while (obuf < oend) {
-
-		// read enough input samples so that opos < 0
-		while ((frac_t)FRAC_ONE <= opos) {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+		// Interpolate a chunk into the intermediate output buffer, which is
+		// then mixed into the output in one go
+		st_sample_t *tmp = outBuf;
+		st_sample_t *tmpEnd = outBuf + MIN<st_size_t>(oend - obuf, ARRAYSIZE(outBuf));
+		bool endOfInput = false;
+
+		while (tmp < tmpEnd) {
+
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				ilast0 = icur0;
+				icur0 = *inPtr++;
+				if (stereo) {
+					ilast1 = icur1;
+					icur1 = *inPtr++;
+				}
+				opos -= FRAC_ONE;
 			}
-			inLen -= (stereo ? 2 : 1);
-			ilast0 = icur0;
-			icur0 = *inPtr++;
-			if (stereo) {
-				ilast1 = icur1;
-				icur1 = *inPtr++;
+
+			if (endOfInput)
+				break;
+
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the output buffer.
+			while (opos < (frac_t)FRAC_ONE && tmp < tmpEnd) {
+				// interpolate
+				st_sample_t out0, out1;
+				out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF) >> FRAC_BITS));
+				out1 = (stereo ?
+							  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF) >> FRAC_BITS)) :
+							  out0);
+
+				*tmp++ = out0;
+				*tmp++ = out1;
+
+				// Increment output position
+				opos += opos_inc;
 			}
-			opos -= FRAC_ONE;
 		}
 
-		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE && obuf < oend) {
-			// interpolate
-			st_sample_t out0, out1;
-			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF) >> FRAC_BITS));
-			out1 = (stereo ?
-						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF) >> FRAC_BITS)) :
-						  out0);
+		const st_size_t numFrames = (tmp - outBuf) / 2;
+		mixSamples<true, reverseStereo>(obuf, outBuf, numFrames, vol_l, vol_r);
+		obuf += numFrames * 2;
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+		if (endOfInput)
+			break;
+	}
+	return (obuf - ostart) / 2;
+}
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
 
-			obuf += 2;
+#pragma mark -
 
-			// Increment output position
-			opos += opos_inc;
+
+/**
+ * The number of filter phases used by the polyphase rate converter. The
+ * fractional input position is rounded down to a multiple of 1/POLYPHASE_PHASES.
+ */
+#define POLYPHASE_PHASE_BITS 8
+#define POLYPHASE_PHASES (1 << POLYPHASE_PHASE_BITS)
+
+/**
+ * Fixed point precision of the polyphase filter coefficients.
+ *
+ * This is chosen so that the dot products in convolve() fit into 32 bits:
+ * their magnitude is at most 32768 times the sum of the magnitudes of the
+ * coefficients of a phase. That sum is 1 << POLYPHASE_COEFF_BITS plus the
+ * negative lobes of the filter. Those add less than 10% for 16 taps and
+ * about 10% for 32 taps, i.e. the sum stays below 36000 with 14 bits (with
+ * 15 bits, 32 taps could overflow on full-scale input). The bound is
+ * checked in computeCoefficients().
+ */
+#define POLYPHASE_COEFF_BITS 14
+
+/**
+ * Compute the dot product of the given samples and filter coefficients.
+ * numTaps must be a multiple of 8. See POLYPHASE_COEFF_BITS for why the
+ * result (and every partial sum) fits into 32 bits.
+ */
+static inline int convolve(const st_sample_t *samples, const int16 *coeffs, int numTaps) {
+#if defined(USE_SSE2_MIXING)
+	__m128i acc = _mm_setzero_si128();
+	for (int i = 0; i < numTaps; i += 8) {
+		const __m128i x = _mm_loadu_si128((const __m128i *)(samples + i));
+		const __m128i h = _mm_load_si128((const __m128i *)(coeffs + i));
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(x, h));
+	}
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(acc);
+#elif defined(USE_NEON_MIXING)
+	int32x4_t acc = vdupq_n_s32(0);
+	for (int i = 0; i < numTaps; i += 8) {
+		const int16x8_t x = vld1q_s16(samples + i);
+		const int16x8_t h = vld1q_s16(coeffs + i);
+		acc = vmlal_s16(acc, vget_low_s16(x), vget_low_s16(h));
+		acc = vmlal_s16(acc, vget_high_s16(x), vget_high_s16(h));
+	}
+	const int32x2_t sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+	return vget_lane_s32(vpadd_s32(sum, sum), 0);
+#else
+	int acc = 0;
+	for (int i = 0; i < numTaps; ++i)
+		acc += samples[i] * coeffs[i];
+	return acc;
+#endif
+}
+
+/**
+ * Audio rate converter based on band-limited interpolation with a windowed
+ * sinc filter.
+ *
+ * The filter is split into POLYPHASE_PHASES sub-filters (phases), one for
+ * each fractional input position, which are computed once when the
+ * converter is created. Each output sample then costs a single dot product
+ * of numTaps input samples with the coefficients of the matching phase.
+ *
+ * When downsampling, the cutoff frequency is lowered to the output Nyquist
+ * frequency, so no aliasing is introduced. The output is delayed by about
+ * numTaps / 2 input samples.
+ *
+ * Limited to sampling frequency <= 65535 Hz.
+ */
+template<bool stereo, bool reverseStereo>
+class PolyphaseRateConverter : public RateConverter {
+protected:
+	st_sample_t inBuf[INTERMEDIATE_BUFFER_SIZE];
+	const st_sample_t *inPtr;
+	int inLen;
+
+	/** resampled stereo output, before volume scaling and mixing */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	/** fractional position of the output stream in input stream unit */
+	frac_t opos;
+
+	/** fractional position increment in the output stream */
+	frac_t opos_inc;
+
+	/** number of filter taps, a multiple of 8 */
+	int numTaps;
+
+	/** filter coefficients, numTaps for each phase */
+	int16 *coeffs;
+	byte *coeffsAlloc;
+
+	/**
+	 * The last numTaps input samples of each channel. Every sample is
+	 * stored twice, numTaps entries apart, so that the newest numTaps
+	 * samples can always be read in one contiguous block starting at histPos.
+	 */
+	st_sample_t *hist[2];
+	int histPos;
+
+	void computeCoefficients(st_rate_t inrate, st_rate_t outrate);
+
+	void pushSample(st_sample_t in0, st_sample_t in1) {
+		hist[0][histPos] = hist[0][histPos + numTaps] = in0;
+		if (stereo)
+			hist[1][histPos] = hist[1][histPos + numTaps] = in1;
+		if (++histPos == numTaps)
+			histPos = 0;
+	}
+
+public:
+	PolyphaseRateConverter(st_rate_t inrate, st_rate_t outrate, int taps);
+	~PolyphaseRateConverter();
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+		return ST_SUCCESS;
+	}
+};
+
+
+/*
+ * Prepare processing.
+ */
+template<bool stereo, bool reverseStereo>
+PolyphaseRateConverter<stereo, reverseStereo>::PolyphaseRateConverter(st_rate_t inrate, st_rate_t outrate, int taps) {
+	if (inrate >= 65536 || outrate >= 65536) {
+		error("rate effect can only handle rates < 65536");
+	}
+
+	assert(taps > 0 && (taps % 8) == 0);
+	numTaps = taps;
+
+	opos = FRAC_ONE;
+	opos_inc = (inrate << FRAC_BITS) / outrate;
+
+	// The coefficients are kept 16 byte aligned for the vector code
+	coeffsAlloc = new byte[POLYPHASE_PHASES * numTaps * sizeof(int16) + 15];
+	coeffs = (int16 *)(((size_t)coeffsAlloc + 15) & ~(size_t)15);
+	computeCoefficients(inrate, outrate);
+
+	hist[0] = new st_sample_t[numTaps * 2 * (stereo ? 2 : 1)];
+	hist[1] = (stereo ? hist[0] + numTaps * 2 : 0);
+	memset(hist[0], 0, numTaps * 2 * (stereo ? 2 : 1) * sizeof(st_sample_t));
+	histPos = 0;
+
+	inLen = 0;
+}
+
+template<bool stereo, bool reverseStereo>
+PolyphaseRateConverter<stereo, reverseStereo>::~PolyphaseRateConverter() {
+	delete[] coeffsAlloc;
+	delete[] hist[0];
+}
+
+/*
+ * Compute the Blackman windowed sinc coefficients for all phases.
+ */
+template<bool stereo, bool reverseStereo>
+void PolyphaseRateConverter<stereo, reverseStereo>::computeCoefficients(st_rate_t inrate, st_rate_t outrate) {
+	// Cutoff frequency relative to the input sample rate, slightly below
+	// the Nyquist frequency of the lower of both rates to leave room for
+	// the transition band.
+	const double cutoff = 0.5 * 0.95 * MIN<double>(1.0, (double)outrate / inrate);
+
+	// Tap numTaps / 2 - 1 is the "last" input sample, tap numTaps / 2 the
+	// "current" one, matching ilast0 and icur0 of the linear converter.
+	const double center = numTaps / 2 - 1;
+
+	for (int phase = 0; phase < POLYPHASE_PHASES; ++phase) {
+		const double frac = (double)phase / POLYPHASE_PHASES;
+		double filter[64];
+		double sum = 0.0;
+		assert(numTaps <= ARRAYSIZE(filter));
+
+		for (int i = 0; i < numTaps; ++i) {
+			const double t = i - center - frac;
+			const double x = 2.0 * M_PI * cutoff * t;
+			const double sinc = (t == 0.0) ? 1.0 : sin(x) / x;
+			const double w = 2.0 * M_PI * (t / numTaps + 0.5);
+			const double window = 0.42 - 0.5 * cos(w) + 0.08 * cos(2.0 * w);
+
+			filter[i] = sinc * window;
+			sum += filter[i];
+		}
+
+		// Normalize the gain of each phase to 1, so constant input signals
+		// result in constant output. The rounding error of the fixed point
+		// coefficients is put into the largest one.
+		int16 *phaseCoeffs = coeffs + phase * numTaps;
+		int fixedSum = 0;
+		for (int i = 0; i < numTaps; ++i) {
+			phaseCoeffs[i] = (int16)floor(filter[i] / sum * (1 << POLYPHASE_COEFF_BITS) + 0.5);
+			fixedSum += phaseCoeffs[i];
+		}
+
+		const int peak = (frac < 0.5) ? (int)center : (int)center + 1;
+		phaseCoeffs[peak] += (1 << POLYPHASE_COEFF_BITS) - fixedSum;
+
+		// Make sure convolve() can't overflow, even for full-scale input
+		int magnitude = 0;
+		for (int i = 0; i < numTaps; ++i)
+			magnitude += ABS<int>(phaseCoeffs[i]);
+		assert(magnitude <= 0x7FFFFFFF / 32768);
+	}
+}
+
+/*
+ * Processed signed long samples from ibuf to obuf.
+ * Return number of sample pairs processed.
+ */
+template<bool stereo, bool reverseStereo>
+int PolyphaseRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	st_sample_t *ostart, *oend;
+
+	ostart = obuf;
+	oend = obuf + osamp * 2;
+
+	while (obuf < oend) {
+		// Filter a chunk into the intermediate output buffer, which is
+		// then mixed into the output in one go
+		st_sample_t *tmp = outBuf;
+		st_sample_t *tmpEnd = outBuf + MIN<st_size_t>(oend - obuf, ARRAYSIZE(outBuf));
+		bool endOfInput = false;
+
+		while (tmp < tmpEnd) {
+
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				const st_sample_t in0 = *inPtr++;
+				const st_sample_t in1 = (stereo ? *inPtr++ : in0);
+				pushSample(in0, in1);
+				opos -= FRAC_ONE;
+			}
+
+			if (endOfInput)
+				break;
+
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the output buffer.
+			while (opos < (frac_t)FRAC_ONE && tmp < tmpEnd) {
+				const int16 *phaseCoeffs = coeffs + (opos >> (FRAC_BITS - POLYPHASE_PHASE_BITS)) * numTaps;
+
+				st_sample_t out0, out1;
+				out0 = (st_sample_t)CLIP<int>((convolve(hist[0] + histPos, phaseCoeffs, numTaps) + (1 << (POLYPHASE_COEFF_BITS - 1))) >> POLYPHASE_COEFF_BITS, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+				out1 = (stereo ?
+						  (st_sample_t)CLIP<int>((convolve(hist[1] + histPos, phaseCoeffs, numTaps) + (1 << (POLYPHASE_COEFF_BITS - 1))) >> POLYPHASE_COEFF_BITS, ST_SAMPLE_MIN, ST_SAMPLE_MAX) :
+						  out0);
+
+				*tmp++ = out0;
+				*tmp++ = out1;
+
+				// Increment output position
+				opos += opos_inc;
+			}
 		}
+
+		const st_size_t numFrames = (tmp - outBuf) / 2;
+		mixSamples<true, reverseStereo>(obuf, outBuf, numFrames, vol_l, vol_r);
+		obuf += numFrames * 2;
+
+		if (endOfInput)
+			break;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -283,11 +714,8 @@ public:
 	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
 		assert(input.isStereo() == stereo);
 
-		st_sample_t *ptr;
 		st_size_t len;
 
-		st_sample_t *ostart = obuf;
-
 		if (stereo)
 			osamp *= 2;
 
@@ -305,21 +733,12 @@ public:
 		len = input.readBuffer(_buffer, osamp);
 
 		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
-
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+		if ((int)len <= 0)
+			return 0;
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
-		}
-		return (obuf - ostart) / 2;
+		const st_size_t numFrames = (stereo ? len / 2 : len);
+		mixSamples<stereo, reverseStereo>(obuf, _buffer, numFrames, vol_l, vol_r);
+		return numFrames;
 	}
 
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
@@ -331,9 +750,13 @@ public:
 #pragma mark -
 
 template<bool stereo, bool reverseStereo>
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality) {
 	if (inrate != outrate) {
-		if ((inrate % outrate) == 0) {
+		if (quality == kRateConverterQualitySincBest) {
+			return new PolyphaseRateConverter<stereo, reverseStereo>(inrate, outrate, 32);
+		} else if (quality == kRateConverterQualitySincFast) {
+			return new PolyphaseRateConverter<stereo, reverseStereo>(inrate, outrate, 16);
+		} else if ((inrate % outrate) == 0) {
 			return new SimpleRateConverter<stereo, reverseStereo>(inrate, outrate);
 		} else {
 			return new LinearRateConverter<stereo, reverseStereo>(inrate, outrate);
@@ -346,14 +769,14 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
 	if (stereo) {
 		if (reverseStereo)
-			return makeRateConverter<true, true>(inrate, outrate);
+			return makeRateConverter<true, true>(inrate, outrate, quality);
 		else
-			return makeRateConverter<true, false>(inrate, outrate);
+			return makeRateConverter<true, false>(inrate, outrate, quality);
 	} else
-		return makeRateConverter<false, false>(inrate, outrate);
+		return makeRateConverter<false, false>(inrate, outrate, quality);
 }
 
 } // End of namespace Audio
@@ -78,7 +78,21 @@ public:
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
+/**
+ * The quality of the rate conversion.
+ *
+ * The default uses linear interpolation, which is cheap but introduces
+ * aliasing when converting e.g. 11025 Hz samples to 48000 Hz. The sinc
+ * qualities use a band-limited polyphase filter with 16 (fast) or 32 (best)
+ * taps per output sample instead.
+ */
+enum RateConverterQuality {
+	kRateConverterQualityDefault = 0,
+	kRateConverterQualitySincFast = 1,
+	kRateConverterQualitySincBest = 2
+};
+
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false, RateConverterQuality quality = kRateConverterQualityDefault);
 
 } // End of namespace Audio
 
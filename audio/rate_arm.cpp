@@ -435,8 +435,11 @@ public:
 
 /**
  * Create and return a RateConverter object for the specified input and output rates.
+ *
+ * The ARM optimised code only offers the default quality, so the quality
+ * parameter is ignored.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
 	if (inrate != outrate) {
 		if ((inrate % outrate) == 0) {
 			if (stereo) {
@@ -158,6 +158,17 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Retrieves the size and the last modification time of the file referred
+	 * by this node, without opening it. Backends which cannot obtain this
+	 * information cheaply need not implement it.
+	 *
+	 * @param size				set to the file size in bytes
+	 * @param modificationTime	set to the modification time, in seconds since
+	 *							an arbitrary, backend specific epoch
+	 * @return true if the information was retrieved, false otherwise.
+	 */
+	virtual bool getFileInfo(int32 &size, uint32 &modificationTime) const { return false; }
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
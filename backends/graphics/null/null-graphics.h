@@ -69,12 +69,12 @@ public:
 
 	void showOverlay() {}
 	void hideOverlay() {}
-	Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat(); }
+	Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0); }
 	void clearOverlay() {}
 	void grabOverlay(OverlayColor *buf, int pitch) {}
 	void copyRectToOverlay(const OverlayColor *buf, int pitch, int x, int y, int w, int h) {}
-	int16 getOverlayHeight() { return 0; }
-	int16 getOverlayWidth() { return 0; }
+	int16 getOverlayHeight() { return 200; }
+	int16 getOverlayWidth() { return 320; }
 
 	bool showMouse(bool visible) { return !visible; }
 	void warpMouse(int x, int y) {}
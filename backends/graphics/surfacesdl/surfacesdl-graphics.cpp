@@ -140,6 +140,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_paletteDirtyStart(0), _paletteDirtyEnd(0),
 	_screenIsLocked(false),
 	_graphicsMutex(0),
+	_scalerThreads(0), _numScalerThreads(0), _scalerDoneSem(0), _scalerThreadsShouldQuit(false),
 #ifdef USE_SDL_DEBUG_FOCUSRECT
 	_enableFocusRectDebugCode(false), _enableFocusRect(false), _focusRect(),
 #endif
@@ -193,6 +194,10 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 #else
 	_videoMode.fullscreen = true;
 #endif
+
+	// Number of additional threads used for scaling, 0 disables them
+	if (ConfMan.hasKey("scaler_threads"))
+		initScalerThreads(ConfMan.getInt("scaler_threads"));
 }
 
 SurfaceSdlGraphicsManager::~SurfaceSdlGraphicsManager() {
@@ -200,6 +205,8 @@ SurfaceSdlGraphicsManager::~SurfaceSdlGraphicsManager() {
 	if (g_system->getEventManager()->getEventDispatcher() != NULL)
 		g_system->getEventManager()->getEventDispatcher()->unregisterObserver(this);
 
+	deinitScalerThreads();
+
 	unloadGFXMode();
 	if (_mouseSurface)
 		SDL_FreeSurface(_mouseSurface);
@@ -214,6 +221,114 @@ SurfaceSdlGraphicsManager::~SurfaceSdlGraphicsManager() {
 	free(_mouseData);
 }
 
+void SurfaceSdlGraphicsManager::initScalerThreads(int numThreads) {
+	numThreads = CLIP<int>(numThreads, 0, MAX_SCALER_THREADS);
+	if (numThreads == 0)
+		return;
+
+	_scalerThreadsShouldQuit = false;
+	_scalerDoneSem = SDL_CreateSemaphore(0);
+	_scalerThreads = new ScalerThread[numThreads];
+
+	for (_numScalerThreads = 0; _numScalerThreads < numThreads; ++_numScalerThreads) {
+		ScalerThread &t = _scalerThreads[_numScalerThreads];
+		t.manager = this;
+		t.startSem = SDL_CreateSemaphore(0);
+		t.thread = SDL_CreateThread(scalerThreadEntry, &t);
+
+		if (!t.thread) {
+			warning("Could not create scaler thread: %s", SDL_GetError());
+			SDL_DestroySemaphore(t.startSem);
+			break;
+		}
+	}
+}
+
+void SurfaceSdlGraphicsManager::deinitScalerThreads() {
+	if (!_scalerThreads)
+		return;
+
+	// Wake up all threads and wait for them to finish
+	_scalerThreadsShouldQuit = true;
+	for (int i = 0; i < _numScalerThreads; ++i)
+		SDL_SemPost(_scalerThreads[i].startSem);
+
+	for (int i = 0; i < _numScalerThreads; ++i) {
+		SDL_WaitThread(_scalerThreads[i].thread, NULL);
+		SDL_DestroySemaphore(_scalerThreads[i].startSem);
+	}
+
+	SDL_DestroySemaphore(_scalerDoneSem);
+	delete[] _scalerThreads;
+
+	_scalerThreads = 0;
+	_numScalerThreads = 0;
+	_scalerDoneSem = 0;
+}
+
+int SDLCALL SurfaceSdlGraphicsManager::scalerThreadEntry(void *arg) {
+	ScalerThread *t = (ScalerThread *)arg;
+	assert(t);
+
+	while (true) {
+		// Wait till there is a band to scale
+		SDL_SemWait(t->startSem);
+
+		if (t->manager->_scalerThreadsShouldQuit)
+			break;
+
+		t->scalerProc(t->src, t->srcPitch, t->dst, t->dstPitch, t->width, t->height);
+
+		SDL_SemPost(t->manager->_scalerDoneSem);
+	}
+
+	return 0;
+}
+
+void SurfaceSdlGraphicsManager::runScaler(ScalerProc *scalerProc, const uint8 *src, uint32 srcPitch, uint8 *dst, uint32 dstPitch, int width, int height, int scale) {
+	int numBands = MIN(_numScalerThreads + 1, height / MIN_SCALER_BAND_HEIGHT);
+
+#if defined(USE_NASM) && defined(USE_HQ_SCALERS)
+	// The assembly versions of the HQ scalers keep their state in global
+	// variables, so they cannot be run in parallel.
+	if (scalerProc == HQ2x || scalerProc == HQ3x)
+		numBands = 1;
+#endif
+
+	if (numBands <= 1) {
+		scalerProc(src, srcPitch, dst, dstPitch, width, height);
+		return;
+	}
+
+	// Hand out all but the first band to the worker threads, spreading the
+	// remaining rows over the first bands
+	const int bandHeight = height / numBands;
+	const int extraRows = height % numBands;
+	int y = bandHeight + (extraRows > 0 ? 1 : 0);
+
+	for (int i = 1; i < numBands; ++i) {
+		ScalerThread &t = _scalerThreads[i - 1];
+		const int h = bandHeight + (i < extraRows ? 1 : 0);
+
+		t.scalerProc = scalerProc;
+		t.src = src + y * srcPitch;
+		t.srcPitch = srcPitch;
+		t.dst = dst + y * scale * dstPitch;
+		t.dstPitch = dstPitch;
+		t.width = width;
+		t.height = h;
+		SDL_SemPost(t.startSem);
+
+		y += h;
+	}
+	assert(y == height);
+
+	scalerProc(src, srcPitch, dst, dstPitch, width, bandHeight + (extraRows > 0 ? 1 : 0));
+
+	for (int i = 1; i < numBands; ++i)
+		SDL_SemWait(_scalerDoneSem);
+}
+
 void SurfaceSdlGraphicsManager::initEventObserver() {
 	// Register the graphics manager as a event observer
 	g_system->getEventManager()->getEventDispatcher()->registerObserver(this, 10, false);
@@ -1088,8 +1203,8 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 					dst_y = real2Aspect(dst_y);
 
 				assert(scalerProc != NULL);
-				scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
-					(byte *)_hwscreen->pixels + rx1 * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h);
+				runScaler(scalerProc, (byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
+					(byte *)_hwscreen->pixels + rx1 * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h, scale1);
 			}
 
 			r->x = rx1;
@@ -306,6 +306,47 @@ protected:
 	 */
 	OSystem::MutexRef _graphicsMutex;
 
+	enum {
+		MAX_SCALER_THREADS = 16,
+		// Don't split dirty rects with fewer source rows than this per band
+		MIN_SCALER_BAND_HEIGHT = 16
+	};
+
+	/**
+	 * A worker thread which runs the scaler on a horizontal band of a dirty
+	 * rect. The bands only overlap in the source rows the scalers read
+	 * around each pixel, which are not modified while scaling.
+	 */
+	struct ScalerThread {
+		SurfaceSdlGraphicsManager *manager;
+		SDL_Thread *thread;
+		SDL_sem *startSem;
+
+		ScalerProc *scalerProc;
+		const uint8 *src;
+		uint32 srcPitch;
+		uint8 *dst;
+		uint32 dstPitch;
+		int width, height;
+	};
+
+	/** Scaler worker threads, the main thread scales the first band itself */
+	ScalerThread *_scalerThreads;
+	int _numScalerThreads;
+	SDL_sem *_scalerDoneSem;
+	bool _scalerThreadsShouldQuit;
+
+	void initScalerThreads(int numThreads);
+	void deinitScalerThreads();
+
+	/**
+	 * Run the scaler, distributing the work over the scaler threads when
+	 * the area is large enough.
+	 */
+	void runScaler(ScalerProc *scalerProc, const uint8 *src, uint32 srcPitch, uint8 *dst, uint32 dstPitch, int width, int height, int scale);
+
+	static int SDLCALL scalerThreadEntry(void *arg);
+
 #ifdef USE_SDL_DEBUG_FOCUSRECT
 	bool _enableFocusRectDebugCode;
 	bool _enableFocusRect;
@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "backends/platform/null/benchmark.h"
+
+#include "common/util.h"
+
+#if defined(POSIX)
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+const uint32 NullBenchmark::_bucketLimits[kHistogramBuckets - 1] = {
+	250, 500, 1000, 2000, 4000, 8000, 16000, 33000, 66000
+};
+
+NullBenchmark::NullBenchmark() {
+	reset();
+}
+
+void NullBenchmark::start() {
+	reset();
+	_running = true;
+}
+
+void NullBenchmark::reset() {
+	_running = false;
+
+	_startWallTime = getWallTime();
+	_lastFrameCPUTime = getCPUTime();
+	_wallTime = 0;
+	_cpuTime = 0;
+
+	_frameCount = 0;
+	_minFrameTime = 0xFFFFFFFF;
+	_maxFrameTime = 0;
+	for (int i = 0; i < kHistogramBuckets; ++i)
+		_histogram[i] = 0;
+}
+
+void NullBenchmark::frameDone() {
+	if (!_running)
+		return;
+
+	const uint64 now = getCPUTime();
+	const uint32 frameTime = (uint32)(now - _lastFrameCPUTime);
+	_lastFrameCPUTime = now;
+
+	int bucket = 0;
+	while (bucket < kHistogramBuckets - 1 && frameTime >= _bucketLimits[bucket])
+		++bucket;
+	_histogram[bucket]++;
+
+	_minFrameTime = MIN(_minFrameTime, frameTime);
+	_maxFrameTime = MAX(_maxFrameTime, frameTime);
+	_cpuTime += frameTime;
+	_frameCount++;
+}
+
+void NullBenchmark::stop() {
+	if (!_running)
+		return;
+
+	_wallTime = (double)(getWallTime() - _startWallTime);
+	_running = false;
+}
+
+Common::String NullBenchmark::getReport(const Common::String &target) const {
+	Common::String report = Common::String::format("Benchmark results for '%s':\n", target.c_str());
+
+	report += Common::String::format("  Frames:          %u\n", _frameCount);
+	report += Common::String::format("  Wall time:       %.1f ms\n", _wallTime / 1000.0);
+	report += Common::String::format("  CPU time:        %.1f ms\n", _cpuTime / 1000.0);
+
+	if (_frameCount) {
+		report += Common::String::format("  Frame CPU time:  min %.3f ms, avg %.3f ms, max %.3f ms\n",
+		                                 _minFrameTime / 1000.0, _cpuTime / _frameCount / 1000.0, _maxFrameTime / 1000.0);
+
+		report += "  Frame CPU time histogram:\n";
+		for (int i = 0; i < kHistogramBuckets; ++i) {
+			Common::String range;
+			if (i == kHistogramBuckets - 1)
+				range = Common::String::format(">= %.2f ms", _bucketLimits[i - 1] / 1000.0);
+			else
+				range = Common::String::format("<  %.2f ms", _bucketLimits[i] / 1000.0);
+
+			report += Common::String::format("    %-14s %8u (%5.1f%%)\n", range.c_str(), _histogram[i], _histogram[i] * 100.0 / _frameCount);
+		}
+	}
+
+	const uint32 peakMemory = getPeakMemory();
+	if (peakMemory)
+		report += Common::String::format("  Peak memory:     %u KB\n", peakMemory);
+
+	return report;
+}
+
+uint64 NullBenchmark::getWallTime() {
+#if defined(POSIX)
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (uint64)tv.tv_sec * 1000000 + tv.tv_usec;
+#else
+	// No clock which is independent of the event recorder available
+	return 0;
+#endif
+}
+
+uint64 NullBenchmark::getCPUTime() {
+#if defined(POSIX)
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return (uint64)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000
+	       + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#else
+	return getWallTime();
+#endif
+}
+
+uint32 NullBenchmark::getPeakMemory() {
+#if defined(POSIX)
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#if defined(MACOSX)
+	// Mac OS X reports bytes instead of KB
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+#else
+	return 0;
+#endif
+}
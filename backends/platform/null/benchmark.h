@@ -0,0 +1,88 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_PLATFORM_NULL_BENCHMARK_H
+#define BACKENDS_PLATFORM_NULL_BENCHMARK_H
+
+#include "common/scummsys.h"
+#include "common/str.h"
+
+/**
+ * Collects per-frame timing statistics while an event recording is played
+ * back as fast as possible (record mode "fast_playback").
+ *
+ * A frame is the time between two consecutive calls of updateScreen. For
+ * every frame the consumed CPU time is put into a histogram. When the run is
+ * finished, a report containing the histogram, the total wall and CPU time
+ * and the peak memory usage of the process is returned by getReport().
+ */
+class NullBenchmark {
+public:
+	NullBenchmark();
+
+	/** Start a new run, discarding all previously collected data. */
+	void start();
+
+	/** Mark the end of a frame. */
+	void frameDone();
+
+	/** Finish the current run. */
+	void stop();
+
+	bool isRunning() const { return _running; }
+
+	/** Get a human readable report of the last run. */
+	Common::String getReport(const Common::String &target) const;
+
+private:
+	enum {
+		kHistogramBuckets = 10
+	};
+
+	static const uint32 _bucketLimits[kHistogramBuckets - 1];
+
+	bool _running;
+
+	// All times are in microseconds
+	uint64 _startWallTime;
+	uint64 _lastFrameCPUTime;
+	double _wallTime;
+	double _cpuTime;
+
+	uint32 _frameCount;
+	uint32 _minFrameTime;
+	uint32 _maxFrameTime;
+	uint32 _histogram[kHistogramBuckets];
+
+	void reset();
+
+	/** Current wall clock time in microseconds. */
+	static uint64 getWallTime();
+
+	/** CPU time consumed by the process so far in microseconds. */
+	static uint64 getCPUTime();
+
+	/** Peak resident set size of the process in KB, 0 when unknown. */
+	static uint32 getPeakMemory();
+};
+
+#endif
@@ -20,14 +20,26 @@
  *
  */
 
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
 #include "backends/modular-backend.h"
 #include "base/main.h"
 
 #if defined(USE_NULL_DRIVER)
+#include "backends/mutex/null/null-mutex.h"
+#include "backends/events/default/default-events.h"
+#include "backends/graphics/null/null-graphics.h"
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
+#include "backends/platform/null/benchmark.h"
 #include "audio/mixer_intern.h"
 #include "common/scummsys.h"
+#include "common/config-manager.h"
+#include "common/EventRecorder.h"
+
+#if defined(POSIX)
+#include <sys/time.h>
+#endif
 
 /*
  * Include header files needed for the getFilesystemFactory() method.
@@ -40,7 +52,7 @@
 	#include "backends/fs/windows/windows-fs-factory.h"
 #endif
 
-class OSystem_NULL : public ModularBackend {
+class OSystem_NULL : public ModularBackend, Common::EventSource {
 public:
 	OSystem_NULL();
 	virtual ~OSystem_NULL();
@@ -53,7 +65,33 @@ public:
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &t) const {}
 
+	virtual void updateScreen();
+
+	virtual void engineInit();
+	virtual void engineDone();
+
 	virtual void logMessage(LogMessageType::Type type, const char *message);
+
+protected:
+	virtual Common::EventSource *getDefaultEventSource() { return this; }
+
+private:
+	/**
+	 * Mix the audio which would have been played back since the last call.
+	 * This is only done when benchmarking, so that the mixer cost is part
+	 * of the measured frame time.
+	 */
+	void mixAudio();
+
+#if defined(POSIX)
+	timeval _startTime;
+#endif
+
+	uint32 _lastMillis;
+	uint32 _lastMixMillis;
+	uint32 _mixRemainder;
+
+	NullBenchmark _benchmark;
 };
 
 OSystem_NULL::OSystem_NULL() {
@@ -66,6 +104,13 @@ OSystem_NULL::OSystem_NULL() {
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+#if defined(POSIX)
+	gettimeofday(&_startTime, 0);
+#endif
+	_lastMillis = 0;
+	_lastMixMillis = 0;
+	_mixRemainder = 0;
 }
 
 OSystem_NULL::~OSystem_NULL() {
@@ -93,10 +138,81 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 uint32 OSystem_NULL::getMillis() {
-	return 0;
+	uint32 millis = 0;
+#if defined(POSIX)
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+	millis = (uint32)((curTime.tv_sec - _startTime.tv_sec) * 1000 + (curTime.tv_usec - _startTime.tv_usec) / 1000);
+#endif
+	g_eventRec.processMillis(millis);
+
+	// Remember the last returned time, so that the backend itself can use
+	// it without consuming entries of a recording which is played back.
+	_lastMillis = millis;
+	return millis;
 }
 
 void OSystem_NULL::delayMillis(uint msecs) {
+	// There is nothing to wait for in the null backend. We still let the
+	// event recorder know, to keep its state consistent.
+	g_eventRec.processDelayMillis(msecs);
+}
+
+void OSystem_NULL::updateScreen() {
+	ModularBackend::updateScreen();
+
+	if (_benchmark.isRunning()) {
+		mixAudio();
+		_benchmark.frameDone();
+	}
+}
+
+void OSystem_NULL::engineInit() {
+	if (!g_eventRec.isFastPlayback())
+		return;
+
+	_lastMixMillis = _lastMillis;
+	_mixRemainder = 0;
+	((Audio::MixerImpl *)_mixer)->setReady(true);
+
+	_benchmark.start();
+}
+
+void OSystem_NULL::engineDone() {
+	if (!_benchmark.isRunning())
+		return;
+
+	_benchmark.stop();
+	((Audio::MixerImpl *)_mixer)->setReady(false);
+
+	Common::String target = ConfMan.getActiveDomainName();
+	if (ConfMan.hasKey("gameid"))
+		target += " (" + ConfMan.get("gameid") + ")";
+	logMessage(LogMessageType::kInfo, _benchmark.getReport(target).c_str());
+}
+
+void OSystem_NULL::mixAudio() {
+	Audio::MixerImpl *mixer = (Audio::MixerImpl *)_mixer;
+
+	// The recorded time might jump backwards, when a new recording starts
+	if (_lastMillis < _lastMixMillis)
+		_lastMixMillis = _lastMillis;
+
+	// Compute the number of stereo samples to mix, keeping track of the
+	// fractional part to avoid drifting
+	const uint32 rate = mixer->getOutputRate();
+	const uint32 elapsed = _lastMillis - _lastMixMillis;
+	const uint32 fraction = (elapsed % 1000) * rate + _mixRemainder;
+	uint32 samples = (elapsed / 1000) * rate + fraction / 1000;
+	_mixRemainder = fraction % 1000;
+	_lastMixMillis = _lastMillis;
+
+	byte buffer[4096];
+	while (samples > 0) {
+		const uint32 count = MIN<uint32>(samples, sizeof(buffer) / 4);
+		mixer->mixCallback(buffer, count * 4);
+		samples -= count;
+	}
 }
 
 void OSystem_NULL::logMessage(LogMessageType::Type type, const char *message) {
@@ -381,6 +381,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 
 	// TODO: deal with settings that require plugins to be loaded
 	if (Base::processSettings(command, settings, res)) {
+		EngineMan.flushDetectionCache();
 		if (res.getCode() != Common::kNoError)
 			warning("%s", res.getDesc().c_str());
 		return res.getCode();
@@ -495,6 +496,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 		setupGraphics(system);
 		launcherDialog();
 	}
+	EngineMan.flushDetectionCache();
 	PluginManager::instance().unloadAllPlugins();
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
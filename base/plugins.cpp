@@ -516,6 +516,12 @@ GameList EngineManager::detectGames(const Common::FSList &fslist) const {
 	EnginePlugin::List plugins;
 	EnginePlugin::List::const_iterator iter;
 	PluginManager::instance().loadFirstPlugin();
+
+	// Only notify the listeners now, since loading the first plugin may
+	// have registered some
+	for (uint i = 0; i < _detectionListeners.size(); i++)
+		_detectionListeners[i]->beginDetectionPass();
+
 	do {
 		plugins = getPlugins();
 		// Iterate over all known games and for each check if it might be
@@ -524,6 +530,10 @@ GameList EngineManager::detectGames(const Common::FSList &fslist) const {
 			candidates.push_back((**iter)->detectGames(fslist));
 		}
 	} while (PluginManager::instance().loadNextPlugin());
+
+	for (uint i = 0; i < _detectionListeners.size(); i++)
+		_detectionListeners[i]->endDetectionPass();
+
 	return candidates;
 }
 
@@ -531,6 +541,15 @@ const EnginePlugin::List &EngineManager::getPlugins() const {
 	return (const EnginePlugin::List &)PluginManager::instance().getPlugins(PLUGIN_TYPE_ENGINE);
 }
 
+void EngineManager::addDetectionListener(DetectionListener *listener) {
+	_detectionListeners.push_back(listener);
+}
+
+void EngineManager::flushDetectionCache() const {
+	for (uint i = 0; i < _detectionListeners.size(); i++)
+		_detectionListeners[i]->flushDetectionCache();
+}
+
 
 // Music plugins
 
@@ -130,6 +130,8 @@ EventRecorder::EventRecorder() {
 	_lastEventMillis = 0;
 
 	_recordMode = kPassthrough;
+	_fastPlayback = false;
+	_playbackQuitSent = false;
 }
 
 EventRecorder::~EventRecorder() {
@@ -149,6 +151,11 @@ void EventRecorder::init() {
 		if (recordModeString.compareToIgnoreCase("playback") == 0) {
 			_recordMode = kRecorderPlayback;
 			debug(3, "EventRecorder: playback");
+		} else if (recordModeString.compareToIgnoreCase("fast_playback") == 0) {
+			// Same as playback, but never wait for the recorded delays
+			_recordMode = kRecorderPlayback;
+			_fastPlayback = true;
+			debug(3, "EventRecorder: fast playback");
 		} else {
 			_recordMode = kPassthrough;
 			debug(3, "EventRecorder: passthrough");
@@ -325,7 +332,7 @@ void EventRecorder::processMillis(uint32 &millis) {
 		if (_recordTimeCount > _playbackTimeCount) {
 			d = readTime(_playbackTimeFile);
 
-			while ((_lastMillis + d > millis) && (_lastMillis + d - millis > 50)) {
+			while (!_fastPlayback && (_lastMillis + d > millis) && (_lastMillis + d - millis > 50)) {
 				_recordMode = kPassthrough;
 				g_system->delayMillis(50);
 				millis = g_system->getMillis();
@@ -343,6 +350,10 @@ void EventRecorder::processMillis(uint32 &millis) {
 
 bool EventRecorder::processDelayMillis(uint &msecs) {
 	if (_recordMode == kRecorderPlayback) {
+		// Never sleep when playing back as fast as possible
+		if (_fastPlayback)
+			return true;
+
 		_recordMode = kPassthrough;
 
 		uint32 millis = g_system->getMillis();
@@ -420,6 +431,13 @@ bool EventRecorder::pollEvent(Event &ev) {
 			_lastEventCount = _eventCount;
 			return true;
 		}
+	} else if (_fastPlayback && !_playbackQuitSent && _recordTimeCount <= _playbackTimeCount) {
+		// Both the recorded events and times are exhausted, so end the
+		// benchmark run. Quitting earlier would make the engine skip the
+		// work done in the remaining recorded frames.
+		ev.type = EVENT_QUIT;
+		_playbackQuitSent = true;
+		return true;
 	}
 
 	return false;
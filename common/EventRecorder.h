@@ -59,6 +59,13 @@ public:
 	/** TODO: Add documentation, this is only used by the backend */
 	bool processDelayMillis(uint &msecs);
 
+	/**
+	 * Check whether a recording is played back as fast as possible, i.e.
+	 * without waiting for the recorded real-time delays. This is used by
+	 * backends to run headless benchmarks.
+	 */
+	bool isFastPlayback() const { return _recordMode == kRecorderPlayback && _fastPlayback; }
+
 private:
 	bool notifyEvent(const Event &ev);
 	bool notifyPoll();
@@ -100,6 +107,8 @@ private:
 		kRecorderPlayback = 2
 	};
 	volatile RecordMode _recordMode;
+	bool _fastPlayback;
+	bool _playbackQuitSent;
 	String _recordFileName;
 	String _recordTempFileName;
 	String _recordTimeFileName;
@@ -205,6 +205,18 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Retrieves the size and the last modification time of the file referred
+	 * by this node without opening it. Not all backends support this; callers
+	 * must be prepared for it to fail.
+	 *
+	 * @param size				set to the file size in bytes
+	 * @param modificationTime	set to the modification time, in seconds since
+	 *							a backend specific epoch
+	 * @return true if the information was retrieved, false otherwise.
+	 */
+	bool getFileInfo(int32 &size, uint32 &modificationTime) const;
+
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -27,6 +27,8 @@
 #include "common/macresman.h"
 #include "common/md5.h"
 #include "common/config-manager.h"
+#include "common/savefile.h"
+#include "common/singleton.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
@@ -132,6 +134,37 @@ bool cleanupPirated(ADGameDescList &matched) {
 }
 
 
+/**
+ * Listings of the sub directories visited by composeFileHashMap. When the
+ * EngineManager runs detection on a directory it asks every engine in turn,
+ * and engines with directory globs would otherwise each list the same sub
+ * directories again, which is slow on network storage. The cache only
+ * exists during one such detection pass (see AdvancedDetectionListener), so a
+ * later scan always sees the current contents of the disk.
+ */
+class DetectionDirCache {
+public:
+	bool getChildren(const Common::FSNode &dir, Common::FSList &files) {
+		ListingMap::const_iterator i = _listings.find(dir.getPath());
+		if (i != _listings.end()) {
+			files = i->_value;
+			return true;
+		}
+
+		if (!dir.getChildren(files, Common::FSNode::kListAll))
+			return false;
+
+		_listings[dir.getPath()] = files;
+		return true;
+	}
+
+private:
+	typedef Common::HashMap<Common::String, Common::FSList> ListingMap;
+	ListingMap _listings;
+};
+
+static DetectionDirCache *s_dirCache = 0;
+
 GameList AdvancedMetaEngine::detectGames(const Common::FSList &fslist) const {
 	ADGameDescList matches;
 	GameList detectedGames;
@@ -249,6 +282,7 @@ Common::Error AdvancedMetaEngine::createInstance(OSystem *syst, Engine **engine)
 
 	// Run the detector on this
 	ADGameDescList matches = detectGame(files.begin()->getParent(), allFiles, language, platform, extra);
+	EngineMan.flushDetectionCache();
 
 	if (cleanupPirated(matches))
 		return Common::kNoGameDataFoundError;
@@ -313,6 +347,267 @@ struct SizeMD5 {
 	Common::String md5;
 };
 
+/**
+ * Persistent cache of the MD5 sums computed during detection, shared by all
+ * AdvancedMetaEngine instances. Entries are keyed by the path of the hashed
+ * file and are only used as long as the size and modification time of the
+ * file(s) they were computed from are unchanged. Backends which cannot report
+ * these (see Common::FSNode::getFileInfo) simply bypass the cache.
+ *
+ * Every run of ScummVM which modifies the cache is a new session. Entries
+ * which haven't been used in kMaxUnusedSessions such sessions, e.g. because
+ * the files were removed, are dropped when the cache is written. Merely
+ * using entries doesn't modify the cache, so that a run which only finds
+ * known files (like every launch of an already detected game) doesn't have
+ * to rewrite it.
+ */
+class DetectionMD5Cache : public Common::Singleton<DetectionMD5Cache> {
+public:
+	/**
+	 * Builds the cache key and the change stamp for the data fork of a file.
+	 * Returns false if the file cannot be stat'ed, in which case it must not
+	 * be cached.
+	 */
+	static bool makeFileKey(const Common::FSNode &node, uint md5Bytes, Common::String &key, Common::String &stamp);
+
+	/**
+	 * Builds the cache key and the change stamp for the resource fork of a
+	 * file, as opened by Common::MacResManager. The stamp covers all of the
+	 * places MacResManager may load the fork from.
+	 */
+	static bool makeResForkKey(const Common::FSNode &parent, const Common::String &fileName, uint md5Bytes, Common::String &key, Common::String &stamp);
+
+	bool lookup(const Common::String &key, const Common::String &stamp, SizeMD5 &result);
+	void store(const Common::String &key, const Common::String &stamp, const SizeMD5 &value);
+
+	/** Writes the cache back to disk if it has been modified. */
+	void flush();
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	DetectionMD5Cache() : _loaded(false), _dirty(false), _session(0) {}
+
+	enum {
+		kMaxUnusedSessions = 30
+	};
+
+	void load();
+
+	struct Entry {
+		Common::String stamp;
+		SizeMD5 value;
+		uint32 lastUsed;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+	EntryMap _entries;
+	bool _loaded;
+	bool _dirty;
+	uint32 _session;
+};
+
+namespace Common {
+DECLARE_SINGLETON(DetectionMD5Cache);
+}
+
+#define DetectionCache DetectionMD5Cache::instance()
+
+/**
+ * Manages the state shared by the detectors of all AdvancedMetaEngines for
+ * the EngineManager: the directory listings of a detection pass and the MD5
+ * cache. It is registered by the first AdvancedMetaEngine created.
+ */
+class AdvancedDetectionListener : public DetectionListener {
+public:
+	virtual void beginDetectionPass() {
+		delete s_dirCache;
+		s_dirCache = new DetectionDirCache();
+	}
+
+	virtual void endDetectionPass() {
+		delete s_dirCache;
+		s_dirCache = 0;
+	}
+
+	virtual void flushDetectionCache() {
+		DetectionCache.flush();
+	}
+};
+
+static AdvancedDetectionListener *s_detectionListener = 0;
+
+static const char *const kDetectionCacheFile = "detection-md5.cache";
+static const uint32 kDetectionCacheVersion = 2;
+
+static void appendFileStamp(const Common::FSNode &node, Common::String &stamp) {
+	int32 size;
+	uint32 mtime;
+
+	if (node.getFileInfo(size, mtime))
+		stamp += Common::String::format("%s:%d:%u;", node.getName().c_str(), size, mtime);
+}
+
+bool DetectionMD5Cache::makeFileKey(const Common::FSNode &node, uint md5Bytes, Common::String &key, Common::String &stamp) {
+	stamp.clear();
+	appendFileStamp(node, stamp);
+	if (stamp.empty())
+		return false;
+
+	key = Common::String::format("d%u:", md5Bytes) + node.getPath();
+	return true;
+}
+
+bool DetectionMD5Cache::makeResForkKey(const Common::FSNode &parent, const Common::String &fileName, uint md5Bytes, Common::String &key, Common::String &stamp) {
+	stamp.clear();
+	appendFileStamp(parent.getChild("._" + fileName), stamp);
+	appendFileStamp(parent.getChild(fileName + ".bin"), stamp);
+	appendFileStamp(parent.getChild(fileName + ".rsrc"), stamp);
+	appendFileStamp(parent.getChild(fileName), stamp);
+	if (stamp.empty())
+		return false;
+
+	key = Common::String::format("r%u:", md5Bytes) + parent.getPath() + "/" + fileName;
+	return true;
+}
+
+bool DetectionMD5Cache::lookup(const Common::String &key, const Common::String &stamp, SizeMD5 &result) {
+	if (!_loaded)
+		load();
+
+	EntryMap::iterator i = _entries.find(key);
+	if (i == _entries.end() || i->_value.stamp != stamp)
+		return false;
+
+	// Remember that the entry is still in use, so that it isn't pruned if
+	// the cache gets written for other reasons
+	i->_value.lastUsed = _session;
+
+	result = i->_value.value;
+	return true;
+}
+
+void DetectionMD5Cache::store(const Common::String &key, const Common::String &stamp, const SizeMD5 &value) {
+	if (!_loaded)
+		load();
+
+	Entry &entry = _entries[key];
+	entry.stamp = stamp;
+	entry.value = value;
+	entry.lastUsed = _session;
+	_dirty = true;
+}
+
+static bool readCacheString(Common::SeekableReadStream &in, Common::String &str) {
+	uint32 len = in.readUint32BE();
+	if (in.eos() || in.err() || len > 4096)
+		return false;
+
+	char *buf = new char[len];
+	bool ok = in.read(buf, len) == len;
+	if (ok)
+		str = Common::String(buf, len);
+	delete[] buf;
+	return ok;
+}
+
+static void writeCacheString(Common::WriteStream &out, const Common::String &str) {
+	out.writeUint32BE(str.size());
+	out.write(str.c_str(), str.size());
+}
+
+void DetectionMD5Cache::load() {
+	_loaded = true;
+	_session = 1;
+
+	Common::SaveFileManager *saveMan = g_system->getSavefileManager();
+	if (!saveMan)
+		return;
+
+	Common::InSaveFile *in = saveMan->openForLoading(kDetectionCacheFile);
+	if (!in)
+		return;
+
+	if (in->readUint32BE() != MKTAG('A', 'D', 'M', 'D') || in->readUint32BE() != kDetectionCacheVersion) {
+		debug(2, "Ignoring detection cache with unknown format");
+		delete in;
+		return;
+	}
+
+	const uint32 lastSession = in->readUint32BE();
+	const uint32 count = in->readUint32BE();
+	bool ok = !in->eos() && !in->err();
+
+	for (uint32 i = 0; i < count && ok; i++) {
+		Common::String key;
+		Entry entry;
+
+		ok = readCacheString(*in, key) && readCacheString(*in, entry.stamp);
+		if (ok) {
+			entry.value.size = in->readSint32BE();
+			ok = !in->eos() && !in->err() && readCacheString(*in, entry.value.md5);
+		}
+		if (ok) {
+			entry.lastUsed = in->readUint32BE();
+			ok = !in->eos() && !in->err();
+		}
+		if (ok)
+			_entries[key] = entry;
+	}
+
+	delete in;
+
+	// Don't trust anything from a truncated or otherwise damaged file, and
+	// make sure it gets replaced
+	if (!ok) {
+		warning("Discarding the damaged detection cache");
+		_entries.clear();
+		_dirty = true;
+		return;
+	}
+
+	_session = lastSession + 1;
+	debug(2, "Loaded %d entries from the detection cache", _entries.size());
+}
+
+void DetectionMD5Cache::flush() {
+	if (!_dirty)
+		return;
+	_dirty = false;
+
+	Common::SaveFileManager *saveMan = g_system->getSavefileManager();
+	if (!saveMan)
+		return;
+
+	// Drop the entries which haven't been used for a long time
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		if (_session - i->_value.lastUsed > kMaxUnusedSessions)
+			_entries.erase(i);
+	}
+
+	Common::OutSaveFile *out = saveMan->openForSaving(kDetectionCacheFile);
+	if (!out) {
+		debug(2, "Could not write the detection cache");
+		return;
+	}
+
+	out->writeUint32BE(MKTAG('A', 'D', 'M', 'D'));
+	out->writeUint32BE(kDetectionCacheVersion);
+	out->writeUint32BE(_session);
+	out->writeUint32BE(_entries.size());
+	for (EntryMap::const_iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		writeCacheString(*out, i->_key);
+		writeCacheString(*out, i->_value.stamp);
+		out->writeSint32BE(i->_value.value.size);
+		writeCacheString(*out, i->_value.value.md5);
+		out->writeUint32BE(i->_value.lastUsed);
+	}
+
+	out->finalize();
+	if (out->err())
+		warning("Failed to write the detection cache");
+	delete out;
+}
+
 typedef Common::HashMap<Common::String, SizeMD5, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SizeMD5Map;
 
 static void reportUnknown(const Common::FSNode &path, const SizeMD5Map &filesSizeMD5) {
@@ -359,8 +654,12 @@ void AdvancedMetaEngine::composeFileHashMap(FileMap &allFiles, const Common::FSL
 			if (!matched)
 				continue;
 
-			if (!file->getChildren(files, Common::FSNode::kListAll))
+			if (s_dirCache) {
+				if (!s_dirCache->getChildren(*file, files))
+					continue;
+			} else if (!file->getChildren(files, Common::FSNode::kListAll)) {
 				continue;
+			}
 
 			composeFileHashMap(allFiles, files, depth - 1);
 		}
@@ -400,6 +699,15 @@ ADGameDescList AdvancedMetaEngine::detectGame(const Common::FSNode &parent, cons
 			// file and as one with resource fork.
 
 			if (g->flags & ADGF_MACRESFORK) {
+				Common::String cacheKey, cacheStamp;
+				bool cacheable = DetectionMD5Cache::makeResForkKey(parent, fname, _md5Bytes, cacheKey, cacheStamp);
+
+				if (cacheable && DetectionCache.lookup(cacheKey, cacheStamp, tmp)) {
+					debug(3, "> '%s': '%s' (cached)", fname.c_str(), tmp.md5.c_str());
+					filesSizeMD5[fname] = tmp;
+					continue;
+				}
+
 				Common::MacResManager macResMan;
 
 				if (macResMan.open(parent, fname)) {
@@ -407,16 +715,32 @@ ADGameDescList AdvancedMetaEngine::detectGame(const Common::FSNode &parent, cons
 					tmp.size = macResMan.getResForkDataSize();
 					debug(3, "> '%s': '%s'", fname.c_str(), tmp.md5.c_str());
 					filesSizeMD5[fname] = tmp;
+
+					if (cacheable)
+						DetectionCache.store(cacheKey, cacheStamp, tmp);
 				}
 			} else {
 				if (allFiles.contains(fname)) {
 					debug(3, "+ %s", fname.c_str());
 
+					const Common::FSNode &node = allFiles[fname];
+					Common::String cacheKey, cacheStamp;
+					bool cacheable = DetectionMD5Cache::makeFileKey(node, _md5Bytes, cacheKey, cacheStamp);
+
+					if (cacheable && DetectionCache.lookup(cacheKey, cacheStamp, tmp)) {
+						debug(3, "> '%s': '%s' (cached)", fname.c_str(), tmp.md5.c_str());
+						filesSizeMD5[fname] = tmp;
+						continue;
+					}
+
 					Common::File testFile;
 
-					if (testFile.open(allFiles[fname])) {
+					if (testFile.open(node)) {
 						tmp.size = (int32)testFile.size();
 						tmp.md5 = Common::computeStreamMD5AsString(testFile, _md5Bytes);
+
+						if (cacheable)
+							DetectionCache.store(cacheKey, cacheStamp, tmp);
 					} else {
 						tmp.size = -1;
 					}
@@ -600,4 +924,9 @@ AdvancedMetaEngine::AdvancedMetaEngine(const void *descs, uint descItemSize, con
 	_guioptions = GUIO_NONE;
 	_maxScanDepth = 1;
 	_directoryGlobs = NULL;
+
+	if (!s_detectionListener) {
+		s_detectionListener = new AdvancedDetectionListener();
+		EngineMan.addDetectionListener(s_detectionListener);
+	}
 }
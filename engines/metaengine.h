@@ -251,6 +251,27 @@ public:
 
 typedef PluginSubclass<MetaEngine> EnginePlugin;
 
+/**
+ * Interface for code which keeps state across the detectors of several
+ * engines, like a cache, and wants to be told by the EngineManager about
+ * the progress of the game detection.
+ *
+ * @see EngineManager::addDetectionListener
+ */
+class DetectionListener {
+public:
+	virtual ~DetectionListener() {}
+
+	/** Called before all engines are asked to detect games in one directory. */
+	virtual void beginDetectionPass() {}
+
+	/** Called after all engines were asked to detect games in one directory. */
+	virtual void endDetectionPass() {}
+
+	/** Called when state gathered during detection should be saved. */
+	virtual void flushDetectionCache() {}
+};
+
 /**
  * Singleton class which manages all Engine plugins.
  */
@@ -260,6 +281,23 @@ public:
 	GameDescriptor findGame(const Common::String &gameName, const EnginePlugin **plugin = NULL) const;
 	GameList detectGames(const Common::FSList &fslist) const;
 	const EnginePlugin::List &getPlugins() const;
+
+	/**
+	 * Registers a listener for the detection passes. The listener must stay
+	 * valid for the rest of the program run. A listener added while
+	 * detectGames() is running takes part from the next pass on.
+	 */
+	void addDetectionListener(DetectionListener *listener);
+
+	/**
+	 * Writes the checksums cached by the game detection to disk. Detection
+	 * doesn't do that by itself, so that scanning many directories in a row
+	 * (e.g. a mass add) doesn't rewrite the cache for every one of them.
+	 */
+	void flushDetectionCache() const;
+
+private:
+	Common::Array<DetectionListener *> _detectionListeners;
 };
 
 /** Convenience shortcut for accessing the engine manager. */
@@ -108,6 +108,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("resource_id",		WRAP_METHOD(Console, cmdResourceId));
 	DCmd_Register("resource_info",		WRAP_METHOD(Console, cmdResourceInfo));
 	DCmd_Register("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
+	DCmd_Register("resource_stats",		WRAP_METHOD(Console, cmdResourceStats));
+	DCmd_Register("resource_pin",		WRAP_METHOD(Console, cmdResourcePin));
 	DCmd_Register("list",				WRAP_METHOD(Console, cmdList));
 	DCmd_Register("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	DCmd_Register("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
@@ -124,6 +126,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("set_palette",		WRAP_METHOD(Console, cmdSetPalette));
 	DCmd_Register("draw_pic",			WRAP_METHOD(Console, cmdDrawPic));
 	DCmd_Register("draw_cel",			WRAP_METHOD(Console, cmdDrawCel));
+	DCmd_Register("view_cache_stats",	WRAP_METHOD(Console, cmdViewCacheStats));
 	DCmd_Register("undither",           WRAP_METHOD(Console, cmdUndither));
 	DCmd_Register("pic_visualize",		WRAP_METHOD(Console, cmdPicVisualize));
 	DCmd_Register("play_video",         WRAP_METHOD(Console, cmdPlayVideo));
@@ -146,6 +149,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	DCmd_Register("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	DCmd_Register("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	DCmd_Register("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	DCmd_Register("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	DCmd_Register("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	DCmd_Register("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -344,6 +348,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" resource_id - Identifies a resource number by splitting it up in resource type and resource number\n");
 	DebugPrintf(" resource_info - Shows info about a resource\n");
 	DebugPrintf(" resource_types - Shows the valid resource types\n");
+	DebugPrintf(" resource_stats - Shows resource cache statistics and sets its memory budget\n");
+	DebugPrintf(" resource_pin - Keeps unlocked resources of a type in memory\n");
 	DebugPrintf(" list - Lists all the resources of a given type\n");
 	DebugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	DebugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
@@ -362,6 +368,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" set_palette - Sets a palette resource\n");
 	DebugPrintf(" draw_pic - Draws a pic resource\n");
 	DebugPrintf(" draw_cel - Draws a cel from a view resource\n");
+	DebugPrintf(" view_cache_stats - Shows view and font cache statistics and sets its memory budget\n");
 	DebugPrintf(" pic_visualize - Enables visualization of the drawing process of EGA pictures\n");
 	DebugPrintf(" undither - Enable/disable undithering\n");
 	DebugPrintf(" play_video - Plays a SEQ, AVI, VMD, RBT or DUK video\n");
@@ -380,6 +387,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	DebugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	DebugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	DebugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	DebugPrintf(" gc_stats - Shows garbage collector statistics\n");
 	DebugPrintf("\n");
 	DebugPrintf("Music/SFX:\n");
 	DebugPrintf(" songlib - Shows the song library\n");
@@ -785,6 +793,64 @@ bool Console::cmdResourceTypes(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceStats(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			resMan->resetTypeStats();
+		} else if (!strcmp(argv[1], "budget") && argc > 2) {
+			resMan->setMaxMemoryLRU(atoi(argv[2]) * 1024);
+		} else if (!strcmp(argv[1], "lru")) {
+			resMan->printLRU();
+			return true;
+		} else {
+			DebugPrintf("Shows the resource cache statistics\n");
+			DebugPrintf("Usage: %s [reset | budget <kilobytes> | lru]\n", argv[0]);
+			DebugPrintf("reset clears the counters, budget sets the memory the cache may use\n");
+			DebugPrintf("for unlocked resources and lru prints the cache contents to the log\n");
+			return true;
+		}
+	}
+
+	DebugPrintf("Memory: %d bytes locked, %d bytes cached (budget %d), %d bytes pinned\n",
+		resMan->getMemoryLocked(), resMan->getMemoryLRU(), resMan->getMaxMemoryLRU(), resMan->getMemoryPinned());
+	DebugPrintf("%-12s %8s %8s %8s %8s\n", "type", "hits", "misses", "evicted", "prefetch");
+	for (int i = 0; i < kResourceTypeInvalid; i++) {
+		const ResourceManager::TypeStats &stats = resMan->getTypeStats((ResourceType)i);
+		if (!stats.hits && !stats.misses && !resMan->isResourceTypePinned((ResourceType)i))
+			continue;
+
+		DebugPrintf("%-12s %8d %8d %8d %8d%s\n", getResourceTypeName((ResourceType)i),
+			stats.hits, stats.misses, stats.evictions, stats.prefetches,
+			resMan->isResourceTypePinned((ResourceType)i) ? " (pinned)" : "");
+	}
+
+	return true;
+}
+
+bool Console::cmdResourcePin(int argc, const char **argv) {
+	if (argc < 2 || argc > 3) {
+		DebugPrintf("Keeps unlocked resources of the given type in memory, instead of\n");
+		DebugPrintf("freeing them when the resource cache exceeds its budget\n");
+		DebugPrintf("Usage: %s <resource type> [on | off]\n", argv[0]);
+		cmdResourceTypes(argc, argv);
+		return true;
+	}
+
+	ResourceType res = parseResourceType(argv[1]);
+	if (res == kResourceTypeInvalid) {
+		DebugPrintf("Resource type '%s' is not valid\n", argv[1]);
+		return true;
+	}
+
+	bool pinned = (argc < 3) || strcmp(argv[2], "off");
+	_engine->getResMan()->setResourceTypePinned(res, pinned);
+	DebugPrintf("Resources of type %s are %s\n", argv[1], pinned ? "pinned" : "no longer pinned");
+
+	return true;
+}
+
 bool Console::cmdHexgrep(int argc, const char **argv) {
 	if (argc < 4) {
 		DebugPrintf("Searches some resources for a particular sequence of bytes, represented as decimal or hexadecimal numbers.\n");
@@ -1562,6 +1628,32 @@ bool Console::cmdPicVisualize(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdViewCacheStats(int argc, const char **argv) {
+	GfxCache *cache = _engine->_gfxCache;
+
+	if (argc > 1) {
+		if (!strcmp(argv[1], "reset")) {
+			cache->resetStats();
+		} else if (!strcmp(argv[1], "budget") && argc > 2) {
+			cache->setMaxMemory(atoi(argv[2]) * 1024);
+		} else {
+			DebugPrintf("Shows the view and font cache statistics\n");
+			DebugPrintf("Usage: %s [reset | budget <kilobytes>]\n", argv[0]);
+			DebugPrintf("reset clears the counters, budget sets the memory the cache may use\n");
+			return true;
+		}
+	}
+
+	DebugPrintf("Memory: %d bytes used (budget %d)\n", cache->getMemoryUsed(), cache->getMaxMemory());
+	DebugPrintf("%-6s %8s %8s %8s %8s\n", "type", "cached", "hits", "misses", "evicted");
+	const GfxCache::Stats &viewStats = cache->getViewStats();
+	DebugPrintf("%-6s %8d %8d %8d %8d\n", "view", cache->getViewCount(), viewStats.hits, viewStats.misses, viewStats.evictions);
+	const GfxCache::Stats &fontStats = cache->getFontStats();
+	DebugPrintf("%-6s %8d %8d %8d %8d\n", "font", cache->getFontCount(), fontStats.hits, fontStats.misses, fontStats.evictions);
+
+	return true;
+}
+
 bool Console::cmdPlayVideo(int argc, const char **argv) {
 	if (argc < 2) {
 		DebugPrintf("Plays a SEQ, AVI, VMD, RBT or DUK video.\n");
@@ -2163,6 +2255,30 @@ bool Console::cmdGCInvoke(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdGCStats(int argc, const char **argv) {
+	GCStatistics &stats = _engine->_gamestate->gcStatistics;
+
+	if (argc > 1) {
+		if (strcmp(argv[1], "reset")) {
+			DebugPrintf("Shows garbage collector statistics\n");
+			DebugPrintf("Usage: %s [reset]\n", argv[0]);
+			return true;
+		}
+		memset(&stats, 0, sizeof(stats));
+	}
+
+	DebugPrintf("Runs: %d\n", stats.runs);
+	DebugPrintf("Mark: last: %d ms, slowest: %d ms, average: %d ms\n",
+		stats.lastMarkMillis, stats.maxMarkMillis, stats.runs ? stats.totalMarkMillis / stats.runs : 0);
+	DebugPrintf("Sweep: last: %d ms, slowest: %d ms, average: %d ms, incremental: %d ms in total\n",
+		stats.lastSweepMillis, stats.maxSweepMillis, stats.runs ? stats.totalSweepMillis / stats.runs : 0,
+		stats.stepMillis);
+	DebugPrintf("Objects freed: %d immediately, %d incrementally, %d queued\n",
+		stats.freedObjects, stats.sweptObjects, _engine->_gamestate->gcPendingFrees.size());
+
+	return true;
+}
+
 bool Console::cmdGCObjects(int argc, const char **argv) {
 	AddrSet *use_map = findAllActiveReferences(_engine->_gamestate);
 
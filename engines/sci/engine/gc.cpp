@@ -22,6 +22,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 namespace Sci {
@@ -160,9 +161,62 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
-void run_gc(EngineState *s) {
+/**
+ * Whether unreachable objects of a segment type may be freed some time after
+ * they were found to be unreachable. This is the case for objects which are
+ * only ever freed by the garbage collector once the scripts lost all their
+ * references to them. Scripts may be unloaded in other ways, which could
+ * lead to their segment (and thus the addresses of their locals) being
+ * reused, and clones can be found again by name.
+ */
+static bool canDeferFree(SegmentType type) {
+	switch (type) {
+	case SEG_TYPE_LISTS:
+	case SEG_TYPE_NODES:
+	case SEG_TYPE_HUNK:
+	case SEG_TYPE_DYNMEM:
+#ifdef ENABLE_SCI32
+	case SEG_TYPE_ARRAY:
+	case SEG_TYPE_STRING:
+#endif
+		return true;
+	default:
+		return false;
+	}
+}
+
+void gcSweepStep(EngineState *s, uint maxObjects) {
 	SegManager *segMan = s->_segMan;
 
+	if (s->gcPendingFrees.empty())
+		return;
+
+	const uint32 startTime = g_system->getMillis();
+
+	while (maxObjects-- && !s->gcPendingFrees.empty()) {
+		const reg_t addr = s->gcPendingFrees.back();
+		s->gcPendingFrees.pop_back();
+
+		SegmentObj *mobj = segMan->getSegmentObj(addr.segment);
+		if (mobj) {
+			mobj->freeAtAddress(segMan, addr);
+			debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+			s->gcStatistics.sweptObjects++;
+		}
+	}
+
+	s->gcStatistics.stepMillis += g_system->getMillis() - startTime;
+}
+
+void run_gc(EngineState *s, bool incremental) {
+	SegManager *segMan = s->_segMan;
+
+	// Objects queued by the previous run are unreachable for good, get rid
+	// of them before the tables are scanned again
+	gcSweepStep(s, s->gcPendingFrees.size());
+
+	const uint32 startTime = g_system->getMillis();
+
 	// Some debug stuff
 	debugC(kDebugLevelGC, "[GC] Running...");
 #ifdef GC_DEBUG_CODE
@@ -175,6 +229,9 @@ void run_gc(EngineState *s) {
 	// Compute the set of all segments references currently in use.
 	AddrSet *activeRefs = findAllActiveReferences(s);
 
+	const uint32 sweepStartTime = g_system->getMillis();
+	const uint32 markDuration = sweepStartTime - startTime;
+
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
 	const Common::Array<SegmentObj *> &heap = segMan->getSegments();
@@ -189,12 +246,18 @@ void run_gc(EngineState *s) {
 
 			// Get a list of all deallocatable objects in this segment,
 			// then free any which are not referenced from somewhere.
+			const bool deferFree = incremental && canDeferFree(mobj->getType());
 			const Common::Array<reg_t> tmp = mobj->listAllDeallocatable(seg);
 			for (Common::Array<reg_t>::const_iterator it = tmp.begin(); it != tmp.end(); ++it) {
 				const reg_t addr = *it;
 				if (!activeRefs->contains(addr)) {
 					// Not found -> we can free it
+					if (deferFree) {
+						s->gcPendingFrees.push_back(addr);
+						continue;
+					}
 					mobj->freeAtAddress(segMan, addr);
+					s->gcStatistics.freedObjects++;
 					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
@@ -207,6 +270,16 @@ void run_gc(EngineState *s) {
 
 	delete activeRefs;
 
+	const uint32 sweepDuration = g_system->getMillis() - sweepStartTime;
+	GCStatistics &stats = s->gcStatistics;
+	stats.runs++;
+	stats.lastMarkMillis = markDuration;
+	stats.maxMarkMillis = MAX(stats.maxMarkMillis, markDuration);
+	stats.totalMarkMillis += markDuration;
+	stats.lastSweepMillis = sweepDuration;
+	stats.maxSweepMillis = MAX(stats.maxSweepMillis, sweepDuration);
+	stats.totalSweepMillis += sweepDuration;
+
 #ifdef GC_DEBUG_CODE
 	// Output debug summary of garbage collection
 	debugC(kDebugLevelGC, "[GC] Summary:");
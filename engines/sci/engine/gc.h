@@ -52,8 +52,25 @@ AddrSet *findAllActiveReferences(EngineState *s);
 /**
  * Runs garbage collection on the current system state
  * @param s The state in which we should gc
+ * @param incremental If true, unreachable lists, nodes, hunks and arrays are
+ *        not freed right away, but queued for gcSweepStep() instead. This
+ *        spreads the cost of freeing them over the following kernel calls.
+ *
+ * Only freeing is incremental. Finding the reachable set (the mark phase)
+ * always runs to completion, so its pause is the same in both modes:
+ * marking in steps would need a write barrier on every reg_t the VM and
+ * the kernel functions store between the steps. The console command
+ * gc_stats shows the time spent in both phases.
+ */
+void run_gc(EngineState *s, bool incremental = false);
+
+/**
+ * Frees some of the unreachable objects queued by an incremental
+ * garbage collection.
+ * @param s The state in which we should gc
+ * @param maxObjects The maximum number of objects to free
  */
-void run_gc(EngineState *s);
+void gcSweepStep(EngineState *s, uint maxObjects);
 
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
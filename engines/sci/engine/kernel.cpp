@@ -917,6 +917,8 @@ void script_adjust_opcode_formats() {
 
 	g_sci->_opcode_formats = new opcode_format[128][4];
 	memcpy(g_sci->_opcode_formats, g_base_opcode_formats, 128*4*sizeof(opcode_format));
+	// The feature detection below already decodes scripts
+	updateInstructionDecoding();
 
 	if (g_sci->_features->detectLofsType() != SCI_VERSION_0_EARLY) {
 		g_sci->_opcode_formats[op_lofsa][0] = Script_Offset;
@@ -942,6 +944,8 @@ void script_adjust_opcode_formats() {
 		g_sci->_opcode_formats[0x4e/2][0] = Script_None;
 	}
 #endif
+
+	updateInstructionDecoding();
 }
 
 } // End of namespace Sci
@@ -58,6 +58,12 @@ enum {
 
 #define HUGE_DISTANCE 0xFFFFFFFF
 
+// Cell size of the edge grid used to speed up visibility tests
+#define EDGE_GRID_CELL_SIZE 32
+
+// Number of kAvoidPath results remembered
+#define AVOIDPATH_CACHE_SIZE 8
+
 #define VERTEX_HAS_EDGES(V) ((V) != CLIST_NEXT(V))
 
 // Error codes
@@ -94,10 +100,14 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Visibility query that last tested the edge starting at this vertex
+	uint32 edgeStamp;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = NULL;
+		edgeStamp = 0;
 	}
 };
 
@@ -235,6 +245,12 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Polygon edges sorted into a uniform grid of EDGE_GRID_CELL_SIZE cells,
+	// so that visibility tests only look at edges near the line segment
+	Common::Array<Vertex *> *_edgeGrid;
+	int _gridWidth, _gridHeight;
+	uint32 _edgeStamp;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = NULL;
 		vertex_end = NULL;
@@ -242,10 +258,15 @@ struct PathfindingState {
 		_prependPoint = NULL;
 		_appendPoint = NULL;
 		vertices = 0;
+		_edgeGrid = NULL;
+		_gridWidth = 0;
+		_gridHeight = 0;
+		_edgeStamp = 0;
 	}
 
 	~PathfindingState() {
 		free(vertex_index);
+		delete[] _edgeGrid;
 
 		delete _prependPoint;
 		delete _appendPoint;
@@ -258,6 +279,10 @@ struct PathfindingState {
 	bool pointOnScreenBorder(const Common::Point &p);
 	bool edgeOnScreenBorder(const Common::Point &p, const Common::Point &q);
 	int findNearPoint(const Common::Point &p, Polygon *polygon, Common::Point *ret);
+
+	void buildEdgeGrid();
+	int gridColumn(int16 x) const { return CLIP<int>(x / EDGE_GRID_CELL_SIZE, 0, _gridWidth - 1); }
+	int gridRow(int16 y) const { return CLIP<int>(y / EDGE_GRID_CELL_SIZE, 0, _gridHeight - 1); }
 };
 
 static Common::Point readPoint(SegmentRef list_r, int offset) {
@@ -653,32 +678,81 @@ static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
 			continue;
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
+		// Check for intersecting edges. Only edges sharing a grid cell with
+		// the bounding box of the line segment can touch it. An edge may be
+		// stored in several cells, so we stamp it to test it only once.
+		const int colStart = s->gridColumn(MIN(vertex_cur->v.x, vertex->v.x));
+		const int colEnd = s->gridColumn(MAX(vertex_cur->v.x, vertex->v.x));
+		const int rowStart = s->gridRow(MIN(vertex_cur->v.y, vertex->v.y));
+		const int rowEnd = s->gridRow(MAX(vertex_cur->v.y, vertex->v.y));
+		const uint32 stamp = ++s->_edgeStamp;
+		bool visible = true;
+
+		for (int row = rowStart; visible && row <= rowEnd; row++) {
+			for (int col = colStart; visible && col <= colEnd; col++) {
+				const Common::Array<Vertex *> &cell = s->_edgeGrid[row * s->_gridWidth + col];
+
+				for (uint j = 0; j < cell.size(); j++) {
+					Vertex *edge = cell[j];
+
+					if (edge->edgeStamp == stamp)
+						continue;
+					edge->edgeStamp = stamp;
+
+					if (between(vertex_cur->v, vertex->v, edge->v)) {
+						// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+						if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge))) {
+							visible = false;
+							break;
+						}
+
+						// This edge won't properly intersect, so we continue
+						continue;
+					}
 
-					// This edge won't properly intersect, so we continue
-					continue;
+					if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v)) {
+						visible = false;
+						break;
+					}
 				}
-
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
 			}
 		}
 
-		if (j == s->vertices)
+		if (visible)
 			visVerts->push_front(vertex);
 	}
 
 	return visVerts;
 }
 
+/**
+ * Sorts all polygon edges into the edge grid. Each edge is added to every
+ * cell covered by its bounding box.
+ */
+void PathfindingState::buildEdgeGrid() {
+	_gridWidth = MAX((_width + EDGE_GRID_CELL_SIZE - 1) / EDGE_GRID_CELL_SIZE, 1);
+	_gridHeight = MAX((_height + EDGE_GRID_CELL_SIZE - 1) / EDGE_GRID_CELL_SIZE, 1);
+
+	delete[] _edgeGrid;
+	_edgeGrid = new Common::Array<Vertex *>[_gridWidth * _gridHeight];
+
+	for (int i = 0; i < vertices; i++) {
+		Vertex *edge = vertex_index[i];
+
+		if (!VERTEX_HAS_EDGES(edge))
+			continue;
+
+		const Common::Point &p = edge->v;
+		const Common::Point &q = CLIST_NEXT(edge)->v;
+		const int colEnd = gridColumn(MAX(p.x, q.x));
+		const int rowEnd = gridRow(MAX(p.y, q.y));
+
+		for (int row = gridRow(MIN(p.y, q.y)); row <= rowEnd; row++)
+			for (int col = gridColumn(MIN(p.x, q.x)); col <= colEnd; col++)
+				_edgeGrid[row * _gridWidth + col].push_back(edge);
+	}
+}
+
 /**
  * Determines if a point lies on the screen border
  * Parameters: (const Common::Point &) p: The point
@@ -1276,6 +1350,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	}
 
 	pf_s->vertices = count;
+	pf_s->buildEdgeGrid();
 
 	return pf_s;
 }
@@ -1383,8 +1458,9 @@ static reg_t allocateOutputArray(SegManager *segMan, int size) {
  * Parameters: (PathfindingState *) p: The pathfinding state
  *             (EngineState *) s: The game state
  * Returns   : (reg_t) Pointer to dynmem containing path
+ *             (int) *outputSize: The number of points allocated for the path
  */
-static reg_t output_path(PathfindingState *p, EngineState *s) {
+static reg_t output_path(PathfindingState *p, EngineState *s, int *outputSize) {
 	int path_len = 0;
 	reg_t output;
 	Vertex *vertex = p->vertex_end;
@@ -1399,7 +1475,8 @@ static reg_t output_path(PathfindingState *p, EngineState *s) {
 	}
 
 	// Allocate memory for path, plus 3 extra for appended point, prepended point and sentinel
-	output = allocateOutputArray(s->_segMan, path_len + 3);
+	*outputSize = path_len + 3;
+	output = allocateOutputArray(s->_segMan, *outputSize);
 	SegmentRef arrayRef = s->_segMan->dereference(output);
 	assert(arrayRef.isValid() && !arrayRef.skipByte);
 
@@ -1454,6 +1531,130 @@ static reg_t output_path(PathfindingState *p, EngineState *s) {
 	return output;
 }
 
+/**
+ * Collects everything a kAvoidPath result depends on, for use as a key into
+ * the path cache.
+ * @param s			the game state
+ * @param poly_list	the SCI polygon list
+ * @param key		receives the key
+ * @return false if the input contains broken polygons, which are not cached
+ */
+static bool getAvoidPathKey(EngineState *s, reg_t poly_list, const Common::Point &start, const Common::Point &end, int width, int height, int opt, Common::Array<int16> &key) {
+	SegManager *segMan = s->_segMan;
+
+	key.clear();
+	key.push_back(start.x);
+	key.push_back(start.y);
+	key.push_back(end.x);
+	key.push_back(end.y);
+	key.push_back(width);
+	key.push_back(height);
+	key.push_back(opt);
+	// Some workarounds depend on the room
+	key.push_back(s->currentRoomNumber());
+
+	if (!poly_list.segment)
+		return true;
+
+	List *list = segMan->lookupList(poly_list);
+	Node *node = segMan->lookupNode(list->first);
+
+	while (node) {
+		if (!node->value.isNull()) {
+			reg_t points = readSelector(segMan, node->value, SELECTOR(points));
+			int size = readSelectorValue(segMan, node->value, SELECTOR(size));
+
+#ifdef ENABLE_SCI32
+			if (segMan->isHeapObject(points))
+				points = readSelector(segMan, points, SELECTOR(data));
+#endif
+
+			key.push_back(readSelectorValue(segMan, node->value, SELECTOR(type)));
+			key.push_back(size);
+
+			if (size != 0) {
+				SegmentRef pointList = segMan->dereference(points);
+
+				if (!pointList.isValid() || pointList.skipByte || pointList.maxSize < size * POLY_POINT_SIZE)
+					return false;
+
+				for (int i = 0; i < size; i++) {
+					Common::Point pt = readPoint(pointList, i);
+					key.push_back(pt.x);
+					key.push_back(pt.y);
+				}
+			}
+		}
+
+		node = segMan->lookupNode(node->succ);
+	}
+
+	return true;
+}
+
+/**
+ * Looks up a kAvoidPath result in the path cache. On a hit, the path is copied
+ * into a newly allocated output array.
+ * @param s		the game state
+ * @param key	the key, as returned by getAvoidPathKey()
+ * @return the output array, or NULL_REG if the path is not cached
+ */
+static reg_t lookupCachedPath(EngineState *s, const Common::Array<int16> &key) {
+	Common::Array<AvoidPathCacheEntry> &cache = s->avoidPathCache;
+
+	for (uint i = 0; i < cache.size(); i++) {
+		if (cache[i].input != key)
+			continue;
+
+		// Move the entry to the front, so that unused paths expire first
+		if (i != 0) {
+			AvoidPathCacheEntry entry = cache.remove_at(i);
+			cache.insert_at(0, entry);
+		}
+
+		const AvoidPathCacheEntry &entry = cache[0];
+		reg_t output = allocateOutputArray(s->_segMan, entry.outputSize);
+		SegmentRef arrayRef = s->_segMan->dereference(output);
+		assert(arrayRef.isValid() && !arrayRef.skipByte);
+
+		for (uint j = 0; j < entry.path.size(); j++)
+			writePoint(arrayRef, j, entry.path[j]);
+
+		return output;
+	}
+
+	return NULL_REG;
+}
+
+/**
+ * Adds a kAvoidPath result to the path cache, evicting the least recently
+ * used entry if the cache is full.
+ * @param s			the game state
+ * @param key		the key, as returned by getAvoidPathKey()
+ * @param output	the output array returned by output_path()
+ * @param outputSize	the number of points allocated for the output array
+ */
+static void cachePath(EngineState *s, const Common::Array<int16> &key, reg_t output, int outputSize) {
+	SegmentRef arrayRef = s->_segMan->dereference(output);
+	assert(arrayRef.isValid() && !arrayRef.skipByte);
+
+	AvoidPathCacheEntry entry;
+	entry.input = key;
+	entry.outputSize = outputSize;
+
+	for (int i = 0; i < outputSize; i++) {
+		Common::Point pt = readPoint(arrayRef, i);
+		entry.path.push_back(pt);
+
+		if (pt == Common::Point(POLY_LAST_POINT, POLY_LAST_POINT))
+			break;
+	}
+
+	s->avoidPathCache.insert_at(0, entry);
+	if (s->avoidPathCache.size() > AVOIDPATH_CACHE_SIZE)
+		s->avoidPathCache.pop_back();
+}
+
 reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 	Common::Point start = Common::Point(argv[0].toSint16(), argv[1].toSint16());
 
@@ -1515,6 +1716,19 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 				g_system->delayMillis(2500);
 		}
 
+		// Scripts tend to ask for the same path over and over again, e.g. while
+		// an actor is blocked, so recent results are kept around. This is
+		// skipped while debugging, as the pathfinder output is of interest then.
+		Common::Array<int16> cacheKey;
+		bool cacheable = !DebugMan.isDebugChannelEnabled(kDebugLevelAvoidPath)
+		                 && getAvoidPathKey(s, poly_list, start, end, width, height, opt, cacheKey);
+
+		if (cacheable) {
+			output = lookupCachedPath(s, cacheKey);
+			if (!output.isNull())
+				return output;
+		}
+
 		PathfindingState *p = convert_polygon_set(s, poly_list, start, end, width, height, opt);
 
 		if (!p) {
@@ -1535,9 +1749,13 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 		// Apply Dijkstra
 		AStar(p);
 
-		output = output_path(p, s);
+		int outputSize;
+		output = output_path(p, s, &outputSize);
 		delete p;
 
+		if (cacheable)
+			cachePath(s, cacheKey, output, outputSize);
+
 		// Memory is freed by explicit calls to Memory
 		return output;
 	}
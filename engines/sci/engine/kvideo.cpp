@@ -27,6 +27,7 @@
 #include "sci/graphics/cursor.h"
 #include "sci/graphics/palette.h"
 #include "sci/graphics/screen.h"
+#include "common/config-manager.h"
 #include "common/events.h"
 #include "common/keyboard.h"
 #include "common/str.h"
@@ -40,6 +41,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "video/coktel_decoder.h"
+#include "sci/graphics/frameout.h"
 #include "sci/video/robot_decoder.h"
 #endif
 
@@ -49,6 +51,15 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 	if (!videoDecoder)
 		return;
 
+	// Decode frames ahead while waiting for the next one to be due, so that
+	// slow frames don't make the video fall behind. This costs an additional
+	// copy of every frame, so it's only done when requested.
+	Video::BufferedVideoDecoder *bufferedDecoder = 0;
+	if (ConfMan.hasKey("buffered_video") && ConfMan.getBool("buffered_video")) {
+		bufferedDecoder = new Video::BufferedVideoDecoder(videoDecoder);
+		videoDecoder = bufferedDecoder;
+	}
+
 	byte *scaleBuffer = 0;
 	byte bytesPerPixel = videoDecoder->getPixelFormat().bytesPerPixel;
 	uint16 width = videoDecoder->getWidth();
@@ -116,11 +127,18 @@ void playVideo(Video::VideoDecoder *videoDecoder, VideoState videoState) {
 				skipVideo = true;
 		}
 
-		g_system->delayMillis(10);
+		if (!bufferedDecoder || !bufferedDecoder->decodeAhead())
+			g_system->delayMillis(10);
 	}
 
 	delete[] scaleBuffer;
 	delete videoDecoder;
+
+#ifdef ENABLE_SCI32
+	// The video was drawn straight to the backend screen
+	if (g_sci->_gfxFrameout)
+		g_sci->_gfxFrameout->forceFullRedraw();
+#endif
 }
 
 reg_t kShowMovie(EngineState *s, int argc, reg_t *argv) {
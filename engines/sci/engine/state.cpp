@@ -25,6 +25,7 @@
 #include "sci/sci.h"	// for INCLUDE_OLDGFX
 #include "sci/debug.h"	// for g_debug_sleeptime_factor
 #include "sci/event.h"
+#include "sci/resource.h"
 
 #include "sci/engine/kernel.h"
 #include "sci/engine/state.h"
@@ -98,6 +99,9 @@ void EngineState::reset(bool isRestoring) {
 	lastWaitTime = 0;
 
 	gcCountDown = 0;
+	gcPendingFrees.clear();
+	memset(&gcStatistics, 0, sizeof(gcStatistics));
+	avoidPathCache.clear();
 
 	_throttleCounter = 0;
 	_throttleLastTime = 0;
@@ -119,6 +123,8 @@ void EngineState::reset(bool isRestoring) {
 }
 
 void EngineState::speedThrottler(uint32 neededSleep) {
+	g_sci->getResMan()->setCurrentRoom(currentRoomNumber());
+
 	if (_throttleTrigger) {
 		uint32 curTime = g_system->getMillis();
 		uint32 duration = curTime - _throttleLastTime;
@@ -139,6 +145,7 @@ void EngineState::wait(int16 ticks) {
 	lastWaitTime = time;
 
 	ticks *= g_debug_sleeptime_factor;
+	g_sci->getResMan()->setCurrentRoom(currentRoomNumber());
 	g_sci->sleep(ticks * 1000 / 60);
 }
 
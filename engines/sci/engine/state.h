@@ -92,6 +92,29 @@ enum {
 	GAMEISRESTARTING_RESTORE = 2
 };
 
+/**
+ * The input and result of a recent kAvoidPath call, see kpathing.cpp
+ */
+struct AvoidPathCacheEntry {
+	Common::Array<int16> input;
+	Common::Array<Common::Point> path;	///< includes the terminating point
+	int outputSize;
+};
+
+/** Garbage collector statistics, shown by the gc_stats console command */
+struct GCStatistics {
+	uint32 runs;		///< Number of times the reachable set was computed
+	uint32 lastMarkMillis;	///< Time the last run spent finding the reachable set
+	uint32 maxMarkMillis;	///< Slowest search for the reachable set
+	uint32 totalMarkMillis;	///< Total time spent finding the reachable set
+	uint32 lastSweepMillis;	///< Time the last run spent freeing or queueing objects
+	uint32 maxSweepMillis;	///< Slowest freeing or queueing of objects
+	uint32 totalSweepMillis;	///< Total time runs spent freeing or queueing objects
+	uint32 stepMillis;	///< Total time spent in gcSweepStep()
+	uint32 freedObjects;	///< Objects freed during the runs
+	uint32 sweptObjects;	///< Objects freed later by gcSweepStep()
+};
+
 class FileHandle {
 public:
 	Common::String _name;
@@ -216,6 +239,10 @@ public:
 	void shrinkStackToBase();
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
+	Common::Array<reg_t> gcPendingFrees; /**< Unreachable objects the gc has not freed yet */
+	GCStatistics gcStatistics;
+
+	Common::Array<AvoidPathCacheEntry> avoidPathCache; /**< Recent kAvoidPath results, most recent first */
 
 	MessageState *_msgState;
 
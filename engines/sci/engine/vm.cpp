@@ -45,6 +45,10 @@ const reg_t TRUE_REG = {0, 1};
 // statement is followed by an unconditional jump (which will most likely lead
 // to an infinite loop). Aids in detecting script bugs such as #3040722.
 //#define ABORT_ON_INFINITE_LOOP
+// Enable the define below to have every executed instruction decoded a second
+// time straight from the opcode format table and compared with the result of
+// the precomputed decoding table.
+//#define VERIFY_INSTRUCTION_DECODING
 
 // validation functionality
 
@@ -458,7 +462,92 @@ static void callKernelFunc(EngineState *s, int kernelCallNr, int argc) {
 		s->_executionStack.pop_back();
 }
 
-int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4]) {
+enum InstructionOperand {
+	kOperandByte,
+	kOperandSByte,
+	kOperandWord
+};
+
+/**
+ * How to decode an instruction with a specific extended opcode. This is the
+ * information in the opcode format table, with the operand size already
+ * resolved using the lower bit of the extended opcode.
+ */
+struct InstructionDecoding {
+	byte operandCount;
+	byte operands[3];	///< Values of InstructionOperand
+	bool invalid;		///< The opcode format contains Script_Invalid
+	bool fileName;		///< op_file: a null-terminated string follows
+};
+
+static InstructionDecoding s_instructionDecoding[256];
+/** The opcode format table s_instructionDecoding was built from */
+static const opcode_format (*s_decodingFormats)[4] = 0;
+
+static void verifyInstructionDecoding();
+
+void updateInstructionDecoding() {
+	for (int extOpcode = 0; extOpcode < 256; extOpcode++) {
+		const byte opcode = extOpcode >> 1;
+		const bool shortOperands = extOpcode & 1;
+		InstructionDecoding &dec = s_instructionDecoding[extOpcode];
+
+		dec.operandCount = 0;
+		dec.invalid = false;
+
+		for (int i = 0; g_sci->_opcode_formats[opcode][i] && !dec.invalid; ++i) {
+			assert(i < 3);
+			switch (g_sci->_opcode_formats[opcode][i]) {
+			case Script_Byte:
+				dec.operands[dec.operandCount++] = kOperandByte;
+				break;
+			case Script_SByte:
+				dec.operands[dec.operandCount++] = kOperandSByte;
+				break;
+			case Script_Word:
+			case Script_SWord:
+				dec.operands[dec.operandCount++] = kOperandWord;
+				break;
+
+			case Script_Variable:
+			case Script_Property:
+			case Script_Local:
+			case Script_Temp:
+			case Script_Global:
+			case Script_Param:
+			case Script_Offset:
+				dec.operands[dec.operandCount++] = shortOperands ? kOperandByte : kOperandWord;
+				break;
+
+			case Script_SVariable:
+			case Script_SRelative:
+				dec.operands[dec.operandCount++] = shortOperands ? kOperandSByte : kOperandWord;
+				break;
+
+			case Script_None:
+			case Script_End:
+				break;
+
+			case Script_Invalid:
+			default:
+				dec.invalid = true;
+			}
+		}
+
+		// See the comment on op_pushSelf in decodeInstruction()
+		dec.fileName = (opcode == op_pushSelf) && shortOperands && g_sci->getGameId() != GID_FANMADE;
+	}
+
+	s_decodingFormats = g_sci->_opcode_formats;
+
+	verifyInstructionDecoding();
+}
+
+/**
+ * Decodes an instruction by interpreting the opcode format table directly.
+ * This is the reference the decoding table is checked against.
+ */
+static int decodeInstruction(const byte *src, byte &extOpcode, int16 opparams[4]) {
 	uint offset = 0;
 	extOpcode = src[offset++]; // Get "extended" opcode (lower bit has special meaning)
 	const byte opcode = extOpcode >> 1;	// get the actual opcode
@@ -542,6 +631,71 @@ int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4])
 	return offset;
 }
 
+/**
+ * Checks that both decoders agree on the given instruction.
+ */
+static void compareInstructionDecoding(const byte *src, byte extOpcode, const int16 opparams[4], int size) {
+	byte refOpcode;
+	int16 refParams[4];
+	const int refSize = decodeInstruction(src, refOpcode, refParams);
+
+	if (refSize != size || refOpcode != extOpcode || memcmp(refParams, opparams, sizeof(refParams)))
+		error("Decoding table mismatch for opcode %02x", extOpcode);
+}
+
+static void verifyInstructionDecoding() {
+	// Decode every valid opcode followed by distinct operand bytes and, for
+	// op_file, a terminated file name
+	byte instruction[8] = { 0, 0x81, 0x92, 0xA3, 0xB4, 0xC5, 0xD6, 0 };
+
+	for (int extOpcode = 0; extOpcode < 256; extOpcode++) {
+		if (s_instructionDecoding[extOpcode].invalid)
+			continue;
+
+		instruction[0] = extOpcode;
+		byte opcode;
+		int16 opparams[4];
+		const int size = readPMachineInstruction(instruction, opcode, opparams);
+		compareInstructionDecoding(instruction, opcode, opparams, size);
+	}
+}
+
+int readPMachineInstruction(const byte *src, byte &extOpcode, int16 opparams[4]) {
+	assert(g_sci->_opcode_formats == s_decodingFormats);
+
+	extOpcode = src[0];
+	const InstructionDecoding &dec = s_instructionDecoding[extOpcode];
+	if (dec.invalid)
+		error("opcode %02x: Invalid", extOpcode);
+
+	const byte *ptr = src + 1;
+	opparams[0] = opparams[1] = opparams[2] = opparams[3] = 0;
+
+	for (int i = 0; i < dec.operandCount; ++i) {
+		switch (dec.operands[i]) {
+		case kOperandByte:
+			opparams[i] = *ptr++;
+			break;
+		case kOperandSByte:
+			opparams[i] = (int8)*ptr++;
+			break;
+		default:
+			opparams[i] = (int16)READ_SCI11ENDIAN_UINT16(ptr);
+			ptr += 2;
+			break;
+		}
+	}
+
+	if (dec.fileName)
+		while (*ptr++) {}
+
+#ifdef VERIFY_INSTRUCTION_DECODING
+	compareInstructionDecoding(src, extOpcode, opparams, ptr - src);
+#endif
+
+	return ptr - src;
+}
+
 void run_vm(EngineState *s) {
 	assert(s);
 
@@ -855,7 +1009,9 @@ void run_vm(EngineState *s) {
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				run_gc(s, true);
+			} else if (!s->gcPendingFrees.empty()) {
+				gcSweepStep(s, GC_SWEEP_STEP);
 			}
 
 			// Call kernel function
@@ -134,9 +134,11 @@ enum {
 	VAR_PARAM = 3
 };
 
-/** Number of kernel calls in between gcs; should be < 50000 */
 enum {
-	GC_INTERVAL = 0x8000
+	/** Number of kernel calls in between gcs; should be < 50000 */
+	GC_INTERVAL = 0x8000,
+	/** Max. number of objects freed per kernel call after an incremental gc */
+	GC_SWEEP_STEP = 64
 };
 
 enum sci_opcodes {
@@ -272,6 +274,14 @@ enum sci_opcodes {
 
 void script_adjust_opcode_formats();
 
+/**
+ * Rebuilds the table readPMachineInstruction() uses to decode instructions
+ * from the current opcode formats. Must be called whenever the formats in
+ * g_sci->_opcode_formats are changed. The new table is checked against the
+ * opcode formats for every valid opcode.
+ */
+void updateInstructionDecoding();
+
 /**
  * Executes function pubfunct of the specified script.
  * @param[in] s				The state which is to be executed with
@@ -327,7 +327,9 @@ void SciEngine::sleep(uint32 msecs) {
 		_eventMan->getSciEvent(SCI_EVENT_PEEK);
 		time = g_system->getMillis();
 		if (time + 10 < wakeup_time) {
-			g_system->delayMillis(10);
+			// Use the idle time to load resources the game is likely to need
+			if (!_resMan->prefetchResources(time + 10))
+				g_system->delayMillis(10);
 		} else {
 			if (time < wakeup_time)
 				g_system->delayMillis(wakeup_time - time);
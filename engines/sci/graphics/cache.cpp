@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/config-manager.h"
 #include "common/util.h"
 #include "common/stack.h"
 #include "graphics/primitives.h"
@@ -35,7 +36,11 @@
 namespace Sci {
 
 GfxCache::GfxCache(ResourceManager *resMan, GfxScreen *screen, GfxPalette *palette)
-	: _resMan(resMan), _screen(screen), _palette(palette) {
+	: _resMan(resMan), _screen(screen), _palette(palette), _useCounter(0), _memoryUsed(0) {
+	_maxMemory = MAX_MEMORY;
+	if (ConfMan.hasKey("view_cache_size"))
+		_maxMemory = MAX<int>(ConfMan.getInt("view_cache_size"), 0) * 1024;
+	resetStats();
 }
 
 GfxCache::~GfxCache() {
@@ -45,8 +50,9 @@ GfxCache::~GfxCache() {
 
 void GfxCache::purgeFontCache() {
 	for (FontCache::iterator iter = _cachedFonts.begin(); iter != _cachedFonts.end(); ++iter) {
-		delete iter->_value;
-		iter->_value = 0;
+		_memoryUsed -= iter->_value.size;
+		delete iter->_value.font;
+		iter->_value.font = 0;
 	}
 
 	_cachedFonts.clear();
@@ -54,36 +60,126 @@ void GfxCache::purgeFontCache() {
 
 void GfxCache::purgeViewCache() {
 	for (ViewCache::iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter) {
-		delete iter->_value;
-		iter->_value = 0;
+		_memoryUsed -= iter->_value.size;
+		delete iter->_value.view;
+		iter->_value.view = 0;
 	}
 
 	_cachedViews.clear();
 }
 
+void GfxCache::resetStats() {
+	memset(&_viewStats, 0, sizeof(_viewStats));
+	memset(&_fontStats, 0, sizeof(_fontStats));
+}
+
+void GfxCache::setMaxMemory(uint32 maxMemory) {
+	_maxMemory = maxMemory;
+	freeOldEntries();
+}
+
+void GfxCache::freeOldEntries() {
+	while (_memoryUsed > _maxMemory) {
+		// Find the least recently used entry. Both caches only hold a few
+		// dozen entries, so a linear search is cheaper than keeping a list.
+		ViewCache::iterator oldestView = _cachedViews.end();
+		FontCache::iterator oldestFont = _cachedFonts.end();
+		uint32 oldestAge = 0;
+
+		for (ViewCache::iterator iter = _cachedViews.begin(); iter != _cachedViews.end(); ++iter) {
+			uint32 age = _useCounter - iter->_value.lastUsed;
+			if (age > oldestAge) {
+				oldestAge = age;
+				oldestView = iter;
+			}
+		}
+		for (FontCache::iterator iter = _cachedFonts.begin(); iter != _cachedFonts.end(); ++iter) {
+			uint32 age = _useCounter - iter->_value.lastUsed;
+			if (age > oldestAge) {
+				oldestAge = age;
+				oldestFont = iter;
+				oldestView = _cachedViews.end();
+			}
+		}
+
+		if (oldestFont != _cachedFonts.end()) {
+			debugC(kDebugLevelGraphics, "GfxCache: freeing font %d (%d bytes)", oldestFont->_key, oldestFont->_value.size);
+			_memoryUsed -= oldestFont->_value.size;
+			delete oldestFont->_value.font;
+			_cachedFonts.erase(oldestFont);
+			_fontStats.evictions++;
+		} else if (oldestView != _cachedViews.end()) {
+			debugC(kDebugLevelGraphics, "GfxCache: freeing view %d (%d bytes)", oldestView->_key, oldestView->_value.size);
+			_memoryUsed -= oldestView->_value.size;
+			delete oldestView->_value.view;
+			_cachedViews.erase(oldestView);
+			_viewStats.evictions++;
+		} else {
+			// Only the entry in use is left
+			break;
+		}
+	}
+}
+
 GfxFont *GfxCache::getFont(GuiResourceId fontId) {
-	if (_cachedFonts.size() >= MAX_CACHED_FONTS)
-		purgeFontCache();
-
-	if (!_cachedFonts.contains(fontId)) {
-		// Create special SJIS font in japanese games, when font 900 is selected
-		if ((fontId == 900) && (g_sci->getLanguage() == Common::JA_JPN))
-			_cachedFonts[fontId] = new GfxFontSjis(_screen, fontId);
-		else
-			_cachedFonts[fontId] = new GfxFontFromResource(_resMan, _screen, fontId);
+	_useCounter++;
+
+	FontCache::iterator iter = _cachedFonts.find(fontId);
+	if (iter != _cachedFonts.end()) {
+		_fontStats.hits++;
+		iter->_value.lastUsed = _useCounter;
+		return iter->_value.font;
 	}
 
-	return _cachedFonts[fontId];
+	_fontStats.misses++;
+
+	CachedFont &entry = _cachedFonts[fontId];
+	// Create special SJIS font in japanese games, when font 900 is selected
+	if ((fontId == 900) && (g_sci->getLanguage() == Common::JA_JPN))
+		entry.font = new GfxFontSjis(_screen, fontId);
+	else
+		entry.font = new GfxFontFromResource(_resMan, _screen, fontId);
+	entry.size = entry.font->getMemoryUsage();
+	entry.lastUsed = _useCounter;
+	_memoryUsed += entry.size;
+
+	GfxFont *font = entry.font;
+	freeOldEntries();
+	return font;
 }
 
 GfxView *GfxCache::getView(GuiResourceId viewId) {
-	if (_cachedViews.size() >= MAX_CACHED_VIEWS)
-		purgeViewCache();
+	_useCounter++;
+
+	ViewCache::iterator iter = _cachedViews.find(viewId);
+	if (iter != _cachedViews.end()) {
+		_viewStats.hits++;
+		iter->_value.lastUsed = _useCounter;
+
+		// Cels get unpacked on demand after the view was handed out, so
+		// pick up whatever got added since the last request
+		uint32 size = iter->_value.view->getMemoryUsage();
+		if (size != iter->_value.size) {
+			_memoryUsed += size - iter->_value.size;
+			iter->_value.size = size;
+			GfxView *view = iter->_value.view;
+			freeOldEntries();
+			return view;
+		}
+		return iter->_value.view;
+	}
+
+	_viewStats.misses++;
 
-	if (!_cachedViews.contains(viewId))
-		_cachedViews[viewId] = new GfxView(_resMan, _screen, _palette, viewId);
+	CachedView &entry = _cachedViews[viewId];
+	entry.view = new GfxView(_resMan, _screen, _palette, viewId);
+	entry.size = entry.view->getMemoryUsage();
+	entry.lastUsed = _useCounter;
+	_memoryUsed += entry.size;
 
-	return _cachedViews[viewId];
+	GfxView *view = entry.view;
+	freeOldEntries();
+	return view;
 }
 
 int16 GfxCache::kernelViewGetCelWidth(GuiResourceId viewId, int16 loopNo, int16 celNo) {
@@ -30,11 +30,13 @@ namespace Sci {
 class GfxFont;
 class GfxView;
 
-typedef Common::HashMap<int, GfxFont *> FontCache;
-typedef Common::HashMap<int, GfxView *> ViewCache;
-
 /**
  * Cache class, handles caching of views/fonts
+ *
+ * Views and fonts are kept until the memory they use exceeds the budget, at
+ * which point the least recently used ones are freed. The budget defaults to
+ * MAX_MEMORY and may be overridden with the "view_cache_size" config key
+ * (in KB).
  */
 class GfxCache {
 public:
@@ -51,16 +53,63 @@ public:
 
 	byte kernelViewGetColorAtCoordinate(GuiResourceId viewId, int16 loopNo, int16 celNo, int16 x, int16 y);
 
+	struct Stats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+	};
+
+	const Stats &getViewStats() const { return _viewStats; }
+	const Stats &getFontStats() const { return _fontStats; }
+	void resetStats();
+
+	uint getViewCount() const { return _cachedViews.size(); }
+	uint getFontCount() const { return _cachedFonts.size(); }
+	uint32 getMemoryUsed() const { return _memoryUsed; }
+	uint32 getMaxMemory() const { return _maxMemory; }
+	void setMaxMemory(uint32 maxMemory);
+
 private:
+	enum {
+		MAX_MEMORY = 4096 * 1024	// 4MB
+	};
+
+	struct CachedFont {
+		GfxFont *font;
+		uint32 size;
+		uint32 lastUsed;
+	};
+
+	struct CachedView {
+		GfxView *view;
+		uint32 size;
+		uint32 lastUsed;
+	};
+
+	typedef Common::HashMap<int, CachedFont> FontCache;
+	typedef Common::HashMap<int, CachedView> ViewCache;
+
 	void purgeFontCache();
 	void purgeViewCache();
 
+	/**
+	 * Frees least recently used views and fonts until the cache fits into
+	 * its budget. The entry that was just requested is never freed.
+	 */
+	void freeOldEntries();
+
 	ResourceManager *_resMan;
 	GfxScreen *_screen;
 	GfxPalette *_palette;
 
 	FontCache _cachedFonts;
 	ViewCache _cachedViews;
+
+	uint32 _useCounter;
+	uint32 _memoryUsed;
+	uint32 _maxMemory;
+	Stats _viewStats;
+	Stats _fontStats;
 };
 
 } // End of namespace Sci
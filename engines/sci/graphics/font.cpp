@@ -62,6 +62,10 @@ GuiResourceId GfxFontFromResource::getResourceId() {
 	return _resourceId;
 }
 
+uint32 GfxFontFromResource::getMemoryUsage() {
+	return _resource->size + _numChars * sizeof(Charinfo);
+}
+
 byte GfxFontFromResource::getHeight() {
 	return _fontHeight;
 }
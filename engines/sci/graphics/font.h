@@ -38,6 +38,7 @@ public:
 	virtual byte getCharWidth(uint16 chr) { return 0; }
 	virtual void draw(uint16 chr, int16 top, int16 left, byte color, bool greyedOutput) {}
 	virtual void drawToBuffer(uint16 chr, int16 top, int16 left, byte color, bool greyedOutput, byte *buffer, int16 width, int16 height) {}
+	virtual uint32 getMemoryUsage() { return 0; }
 };
 
 
@@ -58,6 +59,7 @@ public:
 	// SCI2/2.1 equivalent
 	void drawToBuffer(uint16 chr, int16 top, int16 left, byte color, bool greyedOutput, byte *buffer, int16 width, int16 height);
 #endif
+	uint32 getMemoryUsage();
 
 private:
 	byte getCharHeight(uint16 chr);
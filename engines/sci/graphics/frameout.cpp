@@ -58,6 +58,7 @@ GfxFrameout::GfxFrameout(SegManager *segMan, ResourceManager *resMan, GfxCoordAd
 	_coordAdjuster = (GfxCoordAdjuster32 *)coordAdjuster;
 	_scriptsRunningWidth = 320;
 	_scriptsRunningHeight = 200;
+	_fullRedraw = true;
 }
 
 GfxFrameout::~GfxFrameout() {
@@ -68,6 +69,9 @@ void GfxFrameout::clear() {
 	deletePlaneItems(NULL_REG);
 	_planes.clear();
 	deletePlanePictures(NULL_REG);
+	_lastDrawList.clear();
+	_dirtyRects.clear();
+	_fullRedraw = true;
 }
 
 void GfxFrameout::kernelAddPlane(reg_t object) {
@@ -198,6 +202,7 @@ void GfxFrameout::kernelDeletePlane(reg_t object) {
 			planeRect.right = (planeRect.right * screenRect.width()) / _scriptsRunningWidth;
 			// Blackout removed plane rect
 			_paint32->fillRect(planeRect, 0);
+			addDirtyRect(planeRect);
 			return;
 		}
 	}
@@ -404,6 +409,10 @@ void GfxFrameout::showVideo() {
 
 		g_system->delayMillis(10);
 	}
+
+	// The video went straight to the backend, so none of the screen is
+	// up to date anymore
+	_fullRedraw = true;
 }
 
 void GfxFrameout::createPlaneItemList(reg_t planeObject, FrameoutList &itemList) {
@@ -470,7 +479,7 @@ bool GfxFrameout::isPictureOutOfView(FrameoutEntry *itemEntry, Common::Rect plan
 	return false;
 }
 
-void GfxFrameout::drawPicture(FrameoutEntry *itemEntry, int16 planeOffsetX, int16 planeOffsetY, bool planePictureMirrored) {
+void GfxFrameout::getPictureDrawPosition(FrameoutEntry *itemEntry, int16 planeOffsetX, int16 planeOffsetY, FrameoutDrawEntry &drawEntry) {
 	int16 pictureOffsetX = planeOffsetX;
 	int16 pictureX = itemEntry->x;
 	if ((planeOffsetX) || (itemEntry->picStartX)) {
@@ -493,8 +502,155 @@ void GfxFrameout::drawPicture(FrameoutEntry *itemEntry, int16 planeOffsetX, int1
 		}
 	}
 
-	itemEntry->picture->drawSci32Vga(itemEntry->celNo, pictureX, itemEntry->y, pictureOffsetX, pictureOffsetY, planePictureMirrored);
-	//	warning("picture cel %d %d", itemEntry->celNo, itemEntry->priority);
+	// pictureY is not used for drawing (yet)
+	drawEntry.x = pictureX;
+	drawEntry.y = itemEntry->y;
+	drawEntry.offsetX = pictureOffsetX;
+	drawEntry.offsetY = pictureOffsetY;
+}
+
+bool FrameoutDrawEntry::operator==(const FrameoutDrawEntry &other) const {
+	// Pictures are compared by their resource id, a new picture object
+	// might get allocated at the address of a deleted one
+	return type == other.type && object == other.object && rect == other.rect &&
+		color == other.color && resourceId == other.resourceId &&
+		loopNo == other.loopNo && celNo == other.celNo && x == other.x && y == other.y &&
+		offsetX == other.offsetX && offsetY == other.offsetY && mirrored == other.mirrored &&
+		scaleX == other.scaleX && scaleY == other.scaleY && celRect == other.celRect &&
+		clipRect == other.clipRect && translatedClipRect == other.translatedClipRect &&
+		planeRect == other.planeRect;
+}
+
+void GfxFrameout::addDirtyRect(Common::Rect rect) {
+	Common::Rect screenRect(_screen->getDisplayWidth(), _screen->getDisplayHeight());
+	if (!rect.isValidRect() || !rect.intersects(screenRect))
+		return;
+	rect.clip(screenRect);
+
+	// Merge with all the rects we overlap, the result may overlap others again
+	for (uint i = 0; i < _dirtyRects.size(); ) {
+		if (_dirtyRects[i].intersects(rect)) {
+			rect.extend(_dirtyRects[i]);
+			_dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			i++;
+		}
+	}
+
+	// Many small rects aren't worth the overhead of replaying the frame for
+	// each of them, use their bounding box instead
+	if (_dirtyRects.size() >= MAX_DIRTY_RECTS) {
+		for (uint i = 0; i < _dirtyRects.size(); i++)
+			rect.extend(_dirtyRects[i]);
+		_dirtyRects.clear();
+	}
+
+	_dirtyRects.push_back(rect);
+}
+
+void GfxFrameout::addChangedEntries(const FrameoutDrawList &drawList) {
+	Common::Array<bool> matched;
+	matched.resize(_lastDrawList.size());
+	for (uint i = 0; i < matched.size(); i++)
+		matched[i] = false;
+
+	// Entries that are unchanged and still drawn in the same order as in the
+	// last frame don't need to be redrawn. Text bitmaps are owned by the
+	// scripts and may change at any time, so they are always redrawn.
+	int lastMatch = -1;
+	for (uint i = 0; i < drawList.size(); i++) {
+		const FrameoutDrawEntry &entry = drawList[i];
+		int match = -1;
+
+		if (entry.type != kFrameoutDrawText) {
+			for (uint j = lastMatch + 1; j < _lastDrawList.size() && match == -1; j++) {
+				if (!matched[j] && _lastDrawList[j] == entry)
+					match = j;
+			}
+			for (int j = 0; j < lastMatch && match == -1; j++) {
+				if (!matched[j] && _lastDrawList[j] == entry)
+					match = j;
+			}
+		}
+
+		if (match != -1)
+			matched[match] = true;
+
+		if (match > lastMatch) {
+			lastMatch = match;
+		} else {
+			addDirtyRect(entry.rect);
+		}
+	}
+
+	for (uint j = 0; j < _lastDrawList.size(); j++) {
+		if (!matched[j])
+			addDirtyRect(_lastDrawList[j].rect);
+	}
+}
+
+void GfxFrameout::drawEntries(const FrameoutDrawList &drawList, const Common::Array<Common::Rect> *clipRects) {
+	// Without clip rects, every entry is drawn whole, as if clipped to the
+	// rect it covers
+	Common::Array<Common::Rect> entryClipRects;
+
+	for (FrameoutDrawList::const_iterator entry = drawList.begin(); entry != drawList.end(); ++entry) {
+		// Each entry is drawn once for all the dirty rects it intersects.
+		// The rects don't overlap, so this gives the same result as drawing
+		// the whole list for one rect after the other.
+		entryClipRects.clear();
+		if (clipRects) {
+			for (uint i = 0; i < clipRects->size(); i++) {
+				if (entry->rect.intersects((*clipRects)[i]))
+					entryClipRects.push_back((*clipRects)[i]);
+			}
+			if (entryClipRects.empty())
+				continue;
+		} else {
+			entryClipRects.push_back(entry->rect);
+		}
+
+		switch (entry->type) {
+		case kFrameoutDrawFill:
+			for (uint i = 0; i < entryClipRects.size(); i++) {
+				Common::Rect fillRect = entry->rect;
+				fillRect.clip(entryClipRects[i]);
+				_paint32->fillRect(fillRect, entry->color);
+			}
+			break;
+		case kFrameoutDrawPicture:
+			// The picture cel is only unpacked once for all the rects
+			_coordAdjuster->pictureSetDisplayArea(entry->planeRect);
+			entry->picture->drawSci32Vga(entry->celNo, entry->x, entry->y, entry->offsetX, entry->offsetY, entry->mirrored,
+					clipRects ? &entryClipRects : NULL);
+			break;
+		case kFrameoutDrawView: {
+			GfxView *view = _cache->getView(entry->resourceId);
+			for (uint i = 0; i < entryClipRects.size(); i++) {
+				Common::Rect celClipRect = entry->clipRect;
+				Common::Rect translatedClipRect = entry->translatedClipRect;
+				if (clipRects) {
+					translatedClipRect.clip(entryClipRects[i]);
+					celClipRect = translatedClipRect;
+					celClipRect.translate(entry->clipRect.left - entry->translatedClipRect.left,
+										  entry->clipRect.top - entry->translatedClipRect.top);
+				}
+
+				if ((entry->scaleX == 128) && (entry->scaleY == 128))
+					view->draw(entry->celRect, celClipRect, translatedClipRect,
+						entry->loopNo, entry->celNo, 255, 0, view->isSci2Hires());
+				else
+					view->drawScaled(entry->celRect, celClipRect, translatedClipRect,
+						entry->loopNo, entry->celNo, 255, entry->scaleX, entry->scaleY);
+			}
+			break;
+		}
+		case kFrameoutDrawText:
+			g_sci->_gfxText32->drawTextBitmap(entry->x, entry->y, entry->planeRect, entry->object);
+			break;
+		}
+	}
 }
 
 void GfxFrameout::kernelFrameout() {
@@ -505,6 +661,11 @@ void GfxFrameout::kernelFrameout() {
 
 	_palette->palVaryUpdate();
 
+	// First gather what needs to be drawn for this frame. Everything that
+	// isn't drawing itself happens here, in the same order as before.
+	FrameoutDrawList drawList;
+	FrameoutDrawEntry drawEntry;
+
 	for (PlaneList::iterator it = _planes.begin(); it != _planes.end(); it++) {
 		reg_t planeObject = it->object;
 		uint16 planeLastPriority = it->lastPriority;
@@ -512,11 +673,18 @@ void GfxFrameout::kernelFrameout() {
 		// Update priority here, sq6 sets it w/o UpdatePlane
 		uint16 planePriority = it->priority = readSelectorValue(_segMan, planeObject, SELECTOR(priority));
 
+		drawEntry = FrameoutDrawEntry();
+		drawEntry.object = planeObject;
+
 		it->lastPriority = planePriority;
 		if (planePriority == 0xffff) { // Plane currently not meant to be shown
 			// If plane was shown before, delete plane rect
-			if (planePriority != planeLastPriority)
-				_paint32->fillRect(it->planeRect, 0);
+			if (planePriority != planeLastPriority) {
+				drawEntry.type = kFrameoutDrawFill;
+				drawEntry.rect = drawEntry.planeRect = it->planeRect;
+				drawEntry.color = 0;
+				drawList.push_back(drawEntry);
+			}
 			continue;
 		}
 
@@ -524,8 +692,12 @@ void GfxFrameout::kernelFrameout() {
 		// Since I first wrote the patch, the race has stopped occurring for me though.
 		// I'll leave this for investigation later, when someone can reproduce.
 		//if (it->pictureId == 0xffff)	// FIXME: This is what SSCI does, and fixes the intro of LSL7, but breaks the dialogs in GK1 (adds black boxes)
-		if (it->planeBack)
-			_paint32->fillRect(it->planeRect, it->planeBack);
+		if (it->planeBack) {
+			drawEntry.type = kFrameoutDrawFill;
+			drawEntry.rect = drawEntry.planeRect = it->planeRect;
+			drawEntry.color = it->planeBack;
+			drawList.push_back(drawEntry);
+		}
 
 		GuiResourceId planeMainPictureId = it->pictureId;
 
@@ -541,6 +713,8 @@ void GfxFrameout::kernelFrameout() {
 		for (FrameoutList::iterator listIterator = itemList.begin(); listIterator != itemList.end(); listIterator++) {
 			FrameoutEntry *itemEntry = *listIterator;
 
+			drawEntry = FrameoutDrawEntry();
+
 			if (itemEntry->object.isNull()) {
 				// Picture cel data
 				itemEntry->x = upscaleHorizontalCoordinate(itemEntry->x);
@@ -548,8 +722,22 @@ void GfxFrameout::kernelFrameout() {
 				itemEntry->picStartX = upscaleHorizontalCoordinate(itemEntry->picStartX);
 				itemEntry->picStartY = upscaleVerticalCoordinate(itemEntry->picStartY);
 
-				if (!isPictureOutOfView(itemEntry, it->planeRect, it->planeOffsetX, it->planeOffsetY))
-					drawPicture(itemEntry, it->planeOffsetX, it->planeOffsetY, it->planePictureMirrored);
+				if (!isPictureOutOfView(itemEntry, it->planeRect, it->planeOffsetX, it->planeOffsetY)) {
+					// The palette gets set even if the picture doesn't need
+					// to be redrawn
+					if (itemEntry->celNo == 0)
+						itemEntry->picture->setSci32Palette();
+
+					drawEntry.type = kFrameoutDrawPicture;
+					drawEntry.object = planeObject;
+					drawEntry.resourceId = itemEntry->picture->getResourceId();
+					drawEntry.picture = itemEntry->picture;
+					drawEntry.celNo = itemEntry->celNo;
+					drawEntry.mirrored = it->planePictureMirrored;
+					drawEntry.rect = drawEntry.planeRect = it->planeRect;
+					getPictureDrawPosition(itemEntry, it->planeOffsetX, it->planeOffsetY, drawEntry);
+					drawList.push_back(drawEntry);
+				}
 			} else {
 				GfxView *view = (itemEntry->viewId != 0xFFFF) ? _cache->getView(itemEntry->viewId) : NULL;
 				
@@ -636,20 +824,36 @@ void GfxFrameout::kernelFrameout() {
 					translatedClipRect.translate(it->planeRect.left, it->planeRect.top);
 				}
 
+				drawEntry.object = itemEntry->object;
+
 				if (view) {
 					if (!clipRect.isEmpty()) {
-						if ((itemEntry->scaleX == 128) && (itemEntry->scaleY == 128))
-							view->draw(itemEntry->celRect, clipRect, translatedClipRect, 
-								itemEntry->loopNo, itemEntry->celNo, 255, 0, view->isSci2Hires());
-						else
-							view->drawScaled(itemEntry->celRect, clipRect, translatedClipRect, 
-								itemEntry->loopNo, itemEntry->celNo, 255, itemEntry->scaleX, itemEntry->scaleY);
+						// Merge the view palette in now, drawing it might get skipped
+						Palette *viewPalette = view->getPalette();
+						if (viewPalette)
+							_palette->set(viewPalette, false);
+
+						drawEntry.type = kFrameoutDrawView;
+						drawEntry.resourceId = itemEntry->viewId;
+						drawEntry.loopNo = itemEntry->loopNo;
+						drawEntry.celNo = itemEntry->celNo;
+						drawEntry.scaleX = itemEntry->scaleX;
+						drawEntry.scaleY = itemEntry->scaleY;
+						drawEntry.celRect = itemEntry->celRect;
+						drawEntry.clipRect = clipRect;
+						drawEntry.rect = drawEntry.translatedClipRect = translatedClipRect;
+						drawList.push_back(drawEntry);
 					}
 				}
 
 				// Draw text, if it exists
 				if (lookupSelector(_segMan, itemEntry->object, SELECTOR(text), NULL, NULL) == kSelectorVariable) {
-					g_sci->_gfxText32->drawTextBitmap(itemEntry->x, itemEntry->y, it->planeRect, itemEntry->object);
+					drawEntry.type = kFrameoutDrawText;
+					drawEntry.x = itemEntry->x;
+					drawEntry.y = itemEntry->y;
+					drawEntry.planeRect = it->planeRect;
+					drawEntry.rect = g_sci->_gfxText32->getTextBitmapRect(itemEntry->x, itemEntry->y, it->planeRect, itemEntry->object);
+					drawList.push_back(drawEntry);
 				}
 			}
 		}
@@ -662,7 +866,35 @@ void GfxFrameout::kernelFrameout() {
 		}
 	}
 
-	_screen->copyToScreen();
+	// The dirty rects only work as long as the screen isn't upscaled, as we
+	// would have to track the coordinate system of every entry otherwise
+	if (_screen->getUpscaledHires())
+		_fullRedraw = true;
+
+	if (!_fullRedraw) {
+		addChangedEntries(drawList);
+
+		// Once most of the screen changed, drawing it all at once is cheaper
+		uint32 dirtyArea = 0;
+		for (uint i = 0; i < _dirtyRects.size(); i++)
+			dirtyArea += _dirtyRects[i].width() * _dirtyRects[i].height();
+		if (dirtyArea * 4 >= (uint32)_screen->getDisplayWidth() * _screen->getDisplayHeight() * 3)
+			_fullRedraw = true;
+	}
+
+	if (_fullRedraw) {
+		drawEntries(drawList, NULL);
+		_screen->copyToScreen();
+	} else {
+		debugC(kDebugLevelGraphics, "kFrameout: %d dirty rects", _dirtyRects.size());
+		drawEntries(drawList, &_dirtyRects);
+		for (uint i = 0; i < _dirtyRects.size(); i++)
+			_screen->copyRectToScreen(_dirtyRects[i]);
+	}
+
+	_lastDrawList = drawList;
+	_dirtyRects.clear();
+	_fullRedraw = false;
 
 	g_sci->getEngineState()->_throttleTrigger = true;
 }
@@ -75,6 +75,42 @@ struct PlanePictureEntry {
 
 typedef Common::List<PlanePictureEntry> PlanePictureList;
 
+enum FrameoutDrawType {
+	kFrameoutDrawFill,
+	kFrameoutDrawPicture,
+	kFrameoutDrawView,
+	kFrameoutDrawText
+};
+
+/**
+ * A single drawing operation of a frame. kernelFrameout() records these for
+ * all planes first and compares them against the ones of the previous frame,
+ * so that only the parts of the screen that actually changed get redrawn.
+ */
+struct FrameoutDrawEntry {
+	FrameoutDrawType type;
+	reg_t object;		// plane for fills and pictures, screen item otherwise
+	Common::Rect rect;	// screen area the operation may draw to
+	byte color;			// fills
+	GuiResourceId resourceId;	// pictures and views
+	int16 loopNo;
+	int16 celNo;
+	int16 x, y;			// picture draw position, text position
+	int16 offsetX, offsetY;	// picture scroll position
+	bool mirrored;
+	int16 scaleX;
+	int16 scaleY;
+	Common::Rect celRect;
+	Common::Rect clipRect;
+	Common::Rect translatedClipRect;
+	Common::Rect planeRect;	// picture display area, text plane
+	GfxPicture *picture;
+
+	bool operator==(const FrameoutDrawEntry &other) const;
+};
+
+typedef Common::Array<FrameoutDrawEntry> FrameoutDrawList;
+
 class GfxCache;
 class GfxCoordAdjuster32;
 class GfxPaint32;
@@ -100,6 +136,12 @@ public:
 	void kernelAddPicAt(reg_t planeObj, GuiResourceId pictureId, int16 pictureX, int16 pictureY);
 	void kernelFrameout();
 
+	/**
+	 * Makes the next kernelFrameout() call redraw and update the whole screen.
+	 * Needs to be called whenever something else drew to the screen.
+	 */
+	void forceFullRedraw() { _fullRedraw = true; }
+
 	void addPlanePicture(reg_t object, GuiResourceId pictureId, uint16 startX, uint16 startY = 0);
 	void deletePlanePictures(reg_t object);
 	void clear();
@@ -108,11 +150,15 @@ private:
 	void showVideo();
 	void createPlaneItemList(reg_t planeObject, FrameoutList &itemList);
 	bool isPictureOutOfView(FrameoutEntry *itemEntry, Common::Rect planeRect, int16 planeOffsetX, int16 planeOffsetY);
-	void drawPicture(FrameoutEntry *itemEntry, int16 planeOffsetX, int16 planeOffsetY, bool planePictureMirrored);
+	void getPictureDrawPosition(FrameoutEntry *itemEntry, int16 planeOffsetX, int16 planeOffsetY, FrameoutDrawEntry &drawEntry);
 	int16 upscaleHorizontalCoordinate(int16 coordinate);
 	int16 upscaleVerticalCoordinate(int16 coordinate);
 	Common::Rect upscaleRect(Common::Rect &rect);
 
+	void addDirtyRect(Common::Rect rect);
+	void addChangedEntries(const FrameoutDrawList &drawList);
+	void drawEntries(const FrameoutDrawList &drawList, const Common::Array<Common::Rect> *clipRects);
+
 	SegManager *_segMan;
 	ResourceManager *_resMan;
 	GfxCoordAdjuster32 *_coordAdjuster;
@@ -125,6 +171,14 @@ private:
 	PlaneList _planes;
 	PlanePictureList _planePictures;
 
+	enum {
+		MAX_DIRTY_RECTS = 8
+	};
+
+	FrameoutDrawList _lastDrawList;
+	Common::Array<Common::Rect> _dirtyRects;
+	bool _fullRedraw;
+
 	void sortPlanes();
 
 	uint16 _scriptsRunningWidth;
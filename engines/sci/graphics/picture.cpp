@@ -77,6 +77,7 @@ void GfxPicture::draw(int16 animationNr, bool mirroredFlag, bool addToFlag, int1
 #ifdef ENABLE_SCI32
 	case 0x0e: // SCI32 VGA picture
 		_resourceType = SCI_PICTURE_TYPE_SCI32;
+		setSci32Palette();
 		drawSci32Vga(0, 0, 0, 0, 0, false);
 		break;
 #endif
@@ -184,27 +185,31 @@ int16 GfxPicture::getSci32celPriority(int16 celNo) {
 	return READ_SCI11ENDIAN_UINT16(inbuffer + cel_headerPos + 36);
 }
 
-void GfxPicture::drawSci32Vga(int16 celNo, int16 drawX, int16 drawY, int16 pictureX, int16 pictureY, bool mirrored) {
+void GfxPicture::setSci32Palette() {
 	byte *inbuffer = _resource->data;
 	int size = _resource->size;
-	int header_size = READ_SCI11ENDIAN_UINT16(inbuffer);
 	int palette_data_ptr = READ_SCI11ENDIAN_UINT32(inbuffer + 6);
+	Palette palette;
+
+	// Create palette and set it
+	_palette->createFromData(inbuffer + palette_data_ptr, size - palette_data_ptr, &palette);
+	_palette->set(&palette, true);
+}
+
+// The palette is not set here, callers need to use setSci32Palette() for that
+void GfxPicture::drawSci32Vga(int16 celNo, int16 drawX, int16 drawY, int16 pictureX, int16 pictureY, bool mirrored, const Common::Array<Common::Rect> *clipRects) {
+	byte *inbuffer = _resource->data;
+	int size = _resource->size;
+	int header_size = READ_SCI11ENDIAN_UINT16(inbuffer);
 //	int celCount = inbuffer[2];
 	int cel_headerPos = header_size;
 	int cel_RlePos, cel_LiteralPos;
-	Palette palette;
 
 	// HACK
 	_mirroredFlag = mirrored;
 	_addToFlag = false;
 	_resourceType = SCI_PICTURE_TYPE_SCI32;
 
-	if (celNo == 0) {
-		// Create palette and set it
-		_palette->createFromData(inbuffer + palette_data_ptr, size - palette_data_ptr, &palette);
-		_palette->set(&palette, true);
-	}
-
 	// Header
 	// [headerSize:WORD] [celCount:BYTE] [Unknown:BYTE] [Unknown:WORD] [paletteOffset:DWORD] [Unknown:DWORD]
 	// cel-header follow afterwards, each is 42 bytes
@@ -224,14 +229,14 @@ void GfxPicture::drawSci32Vga(int16 celNo, int16 drawX, int16 drawY, int16 pictu
 	cel_RlePos = READ_SCI11ENDIAN_UINT32(inbuffer + cel_headerPos + 24);
 	cel_LiteralPos = READ_SCI11ENDIAN_UINT32(inbuffer + cel_headerPos + 28);
 
-	drawCelData(inbuffer, size, cel_headerPos, cel_RlePos, cel_LiteralPos, drawX, drawY, pictureX, pictureY);
+	drawCelData(inbuffer, size, cel_headerPos, cel_RlePos, cel_LiteralPos, drawX, drawY, pictureX, pictureY, clipRects);
 	cel_headerPos += 42;
 }
 #endif
 
 extern void unpackCelData(byte *inBuffer, byte *celBitmap, byte clearColor, int pixelCount, int rlePos, int literalPos, ViewType viewType, uint16 width, bool isMacSci11ViewData);
 
-void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos, int literalPos, int16 drawX, int16 drawY, int16 pictureX, int16 pictureY) {
+void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos, int literalPos, int16 drawX, int16 drawY, int16 pictureX, int16 pictureY, const Common::Array<Common::Rect> *clipRects) {
 	byte *celBitmap = NULL;
 	byte *ptr = NULL;
 	byte *headerPtr = inbuffer + headerPos;
@@ -336,8 +341,8 @@ void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos
 	}
 
 	if (displayWidth > 0 && displayHeight > 0) {
-		y = displayArea.top + drawY;
-		lastY = MIN<int16>(height + y, displayArea.bottom);
+		const int16 topY = displayArea.top + drawY;
+		const int16 bottomY = MIN<int16>(height + topY, displayArea.bottom);
 		leftX = displayArea.left + drawX;
 		rightX = MIN<int16>(displayWidth + leftX, displayArea.right);
 
@@ -355,40 +360,63 @@ void GfxPicture::drawCelData(byte *inbuffer, int size, int headerPos, int rlePos
 
 		byte drawMask = priority > 15 ? GFX_SCREEN_MASK_VISUAL : GFX_SCREEN_MASK_VISUAL | GFX_SCREEN_MASK_PRIORITY;
 
-		ptr = celBitmap;
-		ptr += skipCelBitmapPixels;
-		ptr += skipCelBitmapLines * width;
-		if (!_mirroredFlag) {
-			// Draw bitmap to screen
-			x = leftX;
-			while (y < lastY) {
-				curByte = *ptr++;
-				if ((curByte != clearColor) && (priority >= _screen->getPriority(x, y)))
-					_screen->putPixel(x, y, drawMask, curByte, priority, 0);
-
-				x++;
-
-				if (x >= rightX) {
-					ptr += sourcePixelSkipPerRow;
-					x = leftX;
-					y++;
+		// If clip rects are given, only the parts inside them get drawn. The
+		// cel is only unpacked once for all of them.
+		const uint clipRectCount = clipRects ? clipRects->size() : 1;
+		for (uint clipNr = 0; clipNr < clipRectCount; clipNr++) {
+			y = topY;
+			lastY = bottomY;
+			ptr = celBitmap;
+			ptr += skipCelBitmapPixels;
+			ptr += skipCelBitmapLines * width;
+
+			// Rows above the clip rect are skipped right away, every row takes
+			// up width bytes
+			int16 clipLeftX = leftX;
+			int16 clipRightX = rightX;
+			if (clipRects) {
+				const Common::Rect &clipRect = (*clipRects)[clipNr];
+				if (y < clipRect.top) {
+					ptr += (clipRect.top - y) * width;
+					y = clipRect.top;
 				}
+				lastY = MIN<int16>(lastY, clipRect.bottom);
+				clipLeftX = MAX<int16>(leftX, clipRect.left);
+				clipRightX = MIN<int16>(rightX, clipRect.right);
 			}
-		} else {
-			// Draw bitmap to screen (mirrored)
-			x = rightX - 1;
-			while (y < lastY) {
-				curByte = *ptr++;
-				if ((curByte != clearColor) && (priority >= _screen->getPriority(x, y)))
-					_screen->putPixel(x, y, drawMask, curByte, priority, 0);
-
-				if (x == leftX) {
-					ptr += sourcePixelSkipPerRow;
-					x = rightX;
-					y++;
+
+			if (!_mirroredFlag) {
+				// Draw bitmap to screen
+				x = leftX;
+				while (y < lastY) {
+					curByte = *ptr++;
+					if ((curByte != clearColor) && (x >= clipLeftX) && (x < clipRightX) && (priority >= _screen->getPriority(x, y)))
+						_screen->putPixel(x, y, drawMask, curByte, priority, 0);
+
+					x++;
+
+					if (x >= rightX) {
+						ptr += sourcePixelSkipPerRow;
+						x = leftX;
+						y++;
+					}
 				}
+			} else {
+				// Draw bitmap to screen (mirrored)
+				x = rightX - 1;
+				while (y < lastY) {
+					curByte = *ptr++;
+					if ((curByte != clearColor) && (x >= clipLeftX) && (x < clipRightX) && (priority >= _screen->getPriority(x, y)))
+						_screen->putPixel(x, y, drawMask, curByte, priority, 0);
+
+					if (x == leftX) {
+						ptr += sourcePixelSkipPerRow;
+						x = rightX;
+						y++;
+					}
 
-				x--;
+					x--;
+				}
 			}
 		}
 	}
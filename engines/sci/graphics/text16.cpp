@@ -57,15 +57,14 @@ GuiResourceId GfxText16::GetFontId() {
 }
 
 GfxFont *GfxText16::GetFont() {
-	if ((_font == NULL) || (_font->getResourceId() != _ports->_curPort->fontId))
-		_font = _cache->getFont(_ports->_curPort->fontId);
+	// Always go through the cache, it may have freed the font we used last
+	_font = _cache->getFont(_ports->_curPort->fontId);
 
 	return _font;
 }
 
 void GfxText16::SetFont(GuiResourceId fontId) {
-	if ((_font == NULL) || (_font->getResourceId() != fontId))
-		_font = _cache->getFont(fontId);
+	_font = _cache->getFont(fontId);
 
 	_ports->_curPort->fontId = _font->getResourceId();
 	_ports->_curPort->fontHeight = _font->getHeight();
@@ -215,6 +215,32 @@ void GfxText32::drawTextBitmap(int16 x, int16 y, Common::Rect planeRect, reg_t t
 	}
 }
 
+/**
+ * Returns the area of the screen drawTextBitmap() would draw to with the same
+ * arguments, or an empty rect if it wouldn't draw anything.
+ */
+Common::Rect GfxText32::getTextBitmapRect(int16 x, int16 y, Common::Rect planeRect, reg_t textObject) {
+	reg_t hunkId = readSelector(_segMan, textObject, SELECTOR(bitmap));
+	if (hunkId.isNull() || x < 0 || y < 0)
+		return Common::Rect();
+
+	byte *memoryPtr = _segMan->getHunkPointer(hunkId);
+	if (!memoryPtr)
+		return Common::Rect();
+
+	uint16 textX = planeRect.left + x;
+	uint16 textY = planeRect.top + y;
+	uint16 width = READ_LE_UINT16(memoryPtr);
+	uint16 height = READ_LE_UINT16(memoryPtr + 2);
+
+	if (_screen->fontIsUpscaled()) {
+		textX = textX * _screen->getDisplayWidth() / _screen->getWidth();
+		textY = textY * _screen->getDisplayHeight() / _screen->getHeight();
+	}
+
+	return Common::Rect(textX, textY, textX + width, textY + height);
+}
+
 int16 GfxText32::GetLongest(const char *text, int16 maxWidth, GfxFont *font) {
 	uint16 curChar = 0;
 	int16 maxChars = 0, curCharCount = 0;
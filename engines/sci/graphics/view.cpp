@@ -34,7 +34,14 @@ GfxView::GfxView(ResourceManager *resMan, GfxScreen *screen, GfxPalette *palette
 	: _resMan(resMan), _screen(screen), _palette(palette), _resourceId(resourceId) {
 	assert(resourceId != -1);
 	_coordAdjuster = g_sci->_gfxCoordAdjuster;
+	_scaledCelCounter = 0;
 	initData(resourceId);
+
+	// The resource stays locked for as long as we exist, so it's accounted
+	// for here together with the loop and cel tables
+	_memoryUsage = _resourceSize + _loopCount * sizeof(LoopInfo);
+	for (uint16 loopNo = 0; loopNo < _loopCount; loopNo++)
+		_memoryUsage += _loop[loopNo].celCount * sizeof(CelInfo);
 }
 
 GfxView::~GfxView() {
@@ -48,6 +55,9 @@ GfxView::~GfxView() {
 	}
 	delete[] _loop;
 
+	for (uint i = 0; i < _scaledCels.size(); i++)
+		delete[] _scaledCels[i].bitmap;
+
 	_resMan->unlockResource(_resource);
 }
 
@@ -590,6 +600,7 @@ const byte *GfxView::getBitmap(int16 loopNo, int16 celNo) {
 	// allocating memory to store cel's bitmap
 	int pixelCount = width * height;
 	_loop[loopNo].cel[celNo].rawBitmap = new byte[pixelCount];
+	_memoryUsage += pixelCount;
 	byte *pBitmap = _loop[loopNo].cel[celNo].rawBitmap;
 
 	// unpack the actual cel bitmap data
@@ -770,28 +781,49 @@ void GfxView::draw(const Common::Rect &rect, const Common::Rect &clipRect, const
 }
 
 /**
+ * Returns the given cel scaled to scaleX/scaleY. Scaled cels are kept around,
+ * as the same actors are usually drawn at the same scale over and over again.
+ * The least recently used one gets replaced, once MAX_SCALED_CELS are cached.
+ *
  * We don't fully follow sierra sci here, I did the scaling algo myself and it
  * is definitely not pixel-perfect with the one sierra is using. It shouldn't
  * matter because the scaled cel rect is definitely the same as in sierra sci.
  */
-void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect, const Common::Rect &clipRectTranslated,
-			int16 loopNo, int16 celNo, byte priority, int16 scaleX, int16 scaleY) {
-	const Palette *palette = _embeddedPal ? &_viewPalette : &_palette->_sysPalette;
+const byte *GfxView::getScaledBitmap(int16 loopNo, int16 celNo, int16 scaleX, int16 scaleY, int16 &scaledWidth, int16 &scaledHeight) {
+	loopNo = CLIP<int16>(loopNo, 0, _loopCount -1);
+	celNo = CLIP<int16>(celNo, 0, _loop[loopNo].celCount - 1);
+
+	_scaledCelCounter++;
+
+	ScaledCel *cached = NULL;
+	for (uint i = 0; i < _scaledCels.size(); i++) {
+		ScaledCel &scaledCel = _scaledCels[i];
+		if (scaledCel.loopNo == loopNo && scaledCel.celNo == celNo && scaledCel.scaleX == scaleX && scaledCel.scaleY == scaleY) {
+			scaledCel.lastUsed = _scaledCelCounter;
+			scaledWidth = scaledCel.width;
+			scaledHeight = scaledCel.height;
+			return scaledCel.bitmap;
+		}
+		if (!cached || _scaledCelCounter - scaledCel.lastUsed > _scaledCelCounter - cached->lastUsed)
+			cached = &scaledCel;
+	}
+
+	if (_scaledCels.size() < MAX_SCALED_CELS) {
+		_scaledCels.push_back(ScaledCel());
+		cached = &_scaledCels.back();
+	} else {
+		_memoryUsage -= cached->width * cached->height;
+		delete[] cached->bitmap;
+	}
+
 	const CelInfo *celInfo = getCelInfo(loopNo, celNo);
 	const byte *bitmap = getBitmap(loopNo, celNo);
 	const int16 celHeight = celInfo->height;
 	const int16 celWidth = celInfo->width;
-	const byte clearKey = celInfo->clearKey;
-	const byte drawMask = priority > 15 ? GFX_SCREEN_MASK_VISUAL : GFX_SCREEN_MASK_VISUAL|GFX_SCREEN_MASK_PRIORITY;
 	uint16 scalingX[640];
 	uint16 scalingY[480];
-	int16 scaledWidth, scaledHeight;
 	int pixelNo, scaledPixel, scaledPixelNo, prevScaledPixelNo;
 
-	if (_embeddedPal)
-		// Merge view palette in...
-		_palette->set(&_viewPalette, false);
-
 	scaledWidth = (celInfo->width * scaleX) >> 7;
 	scaledHeight = (celInfo->height * scaleY) >> 7;
 	scaledWidth = CLIP<int16>(scaledWidth, 0, _screen->getWidth());
@@ -833,8 +865,40 @@ void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect,
 	for (; scaledPixelNo < scaledWidth; scaledPixelNo++)
 		scalingX[scaledPixelNo] = pixelNo;
 
-	scaledWidth = MIN(clipRect.width(), scaledWidth);
-	scaledHeight = MIN(clipRect.height(), scaledHeight);
+	byte *scaledBitmap = new byte[scaledWidth * scaledHeight];
+	byte *outPtr = scaledBitmap;
+	for (int y = 0; y < scaledHeight; y++) {
+		const byte *inPtr = bitmap + scalingY[y] * celWidth;
+		for (int x = 0; x < scaledWidth; x++)
+			*outPtr++ = inPtr[scalingX[x]];
+	}
+
+	cached->loopNo = loopNo;
+	cached->celNo = celNo;
+	cached->scaleX = scaleX;
+	cached->scaleY = scaleY;
+	cached->width = scaledWidth;
+	cached->height = scaledHeight;
+	cached->bitmap = scaledBitmap;
+	cached->lastUsed = _scaledCelCounter;
+	_memoryUsage += scaledWidth * scaledHeight;
+
+	return scaledBitmap;
+}
+
+void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect, const Common::Rect &clipRectTranslated,
+			int16 loopNo, int16 celNo, byte priority, int16 scaleX, int16 scaleY) {
+	const Palette *palette = _embeddedPal ? &_viewPalette : &_palette->_sysPalette;
+	const CelInfo *celInfo = getCelInfo(loopNo, celNo);
+	const byte clearKey = celInfo->clearKey;
+	const byte drawMask = priority > 15 ? GFX_SCREEN_MASK_VISUAL : GFX_SCREEN_MASK_VISUAL|GFX_SCREEN_MASK_PRIORITY;
+	int16 scaledWidth, scaledHeight;
+
+	if (_embeddedPal)
+		// Merge view palette in...
+		_palette->set(&_viewPalette, false);
+
+	const byte *scaledBitmap = getScaledBitmap(loopNo, celNo, scaleX, scaleY, scaledWidth, scaledHeight);
 
 	const int16 offsetY = clipRect.top - rect.top;
 	const int16 offsetX = clipRect.left - rect.left;
@@ -843,11 +907,13 @@ void GfxView::drawScaled(const Common::Rect &rect, const Common::Rect &clipRect,
 	if (offsetX < 0 || offsetY < 0)
 		return;
 
-	assert(scaledHeight + offsetY <= ARRAYSIZE(scalingY));
-	assert(scaledWidth + offsetX <= ARRAYSIZE(scalingX));
-	for (int y = 0; y < scaledHeight; y++) {
-		for (int x = 0; x < scaledWidth; x++) {
-			const byte color = bitmap[scalingY[y + offsetY] * celWidth + scalingX[x + offsetX]];
+	const int16 width = MIN<int16>(clipRect.width(), scaledWidth - offsetX);
+	const int16 height = MIN<int16>(clipRect.height(), scaledHeight - offsetY);
+
+	for (int y = 0; y < height; y++) {
+		const byte *inPtr = scaledBitmap + (y + offsetY) * scaledWidth + offsetX;
+		for (int x = 0; x < width; x++) {
+			const byte color = inPtr[x];
 			const int x2 = clipRectTranslated.left + x;
 			const int y2 = clipRectTranslated.top + y;
 			if (color != clearKey && priority >= _screen->getPriority(x2, y2)) {
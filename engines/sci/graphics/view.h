@@ -87,10 +87,14 @@ public:
 
 	byte getColorAtCoordinate(int16 loopNo, int16 celNo, int16 x, int16 y);
 
+	/** Returns the number of bytes held by this view, including unpacked cels */
+	uint32 getMemoryUsage() const { return _memoryUsage; }
+
 private:
 	void initData(GuiResourceId resourceId);
 	void unpackCel(int16 loopNo, int16 celNo, byte *outPtr, uint32 pixelCount);
 	void unditherBitmap(byte *bitmap, int16 width, int16 height, byte clearKey);
+	const byte *getScaledBitmap(int16 loopNo, int16 celNo, int16 scaleX, int16 scaleY, int16 &scaledWidth, int16 &scaledHeight);
 
 	ResourceManager *_resMan;
 	GfxCoordAdjuster *_coordAdjuster;
@@ -104,6 +108,28 @@ private:
 
 	uint16 _loopCount;
 	LoopInfo *_loop;
+	uint32 _memoryUsage;
+
+	enum {
+		MAX_SCALED_CELS = 16
+	};
+
+	// Scaled cels are keyed by loop, cel and scale. Mirroring is already part
+	// of the unpacked cel and the palette mapping happens while drawing, so
+	// neither needs to be part of the key.
+	struct ScaledCel {
+		int16 loopNo;
+		int16 celNo;
+		int16 scaleX;
+		int16 scaleY;
+		int16 width;
+		int16 height;
+		byte *bitmap;
+		uint32 lastUsed;
+	};
+
+	Common::Array<ScaledCel> _scaledCels;
+	uint32 _scaledCelCounter;
 	bool _embeddedPal;
 	Palette _viewPalette;
 
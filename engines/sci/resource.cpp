@@ -22,9 +22,11 @@
 
 // Resource library
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 
 #include "sci/resource.h"
@@ -193,6 +195,9 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : _resMan(resMan), _i
 	_source = NULL;
 	_header = NULL;
 	_headerSize = 0;
+	_lruPrev = NULL;
+	_lruNext = NULL;
+	_lruPinned = false;
 }
 
 Resource::~Resource() {
@@ -891,7 +896,21 @@ ResourceManager::ResourceManager() {
 void ResourceManager::init(bool initFromFallbackDetector) {
 	_memoryLocked = 0;
 	_memoryLRU = 0;
+	_memoryPinned = 0;
+	_maxMemoryLRU = MAX_MEMORY;
+	if (ConfMan.hasKey("resource_cache_size"))
+		_maxMemoryLRU = MAX<int>(ConfMan.getInt("resource_cache_size"), 0) * 1024;
 	_LRU.clear();
+	_pinnedLRU.clear();
+	for (int i = 0; i < kResourceTypeInvalid; i++)
+		_pinnedTypes[i] = false;
+	resetTypeStats();
+
+	_prefetchEnabled = !ConfMan.hasKey("resource_prefetch") || ConfMan.getBool("resource_prefetch");
+	_currentRoom = kNoRoom;
+	_roomResources.clear();
+	_roomSuccessors.clear();
+	_prefetchQueue.clear();
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 
@@ -989,13 +1008,42 @@ ResourceManager::~ResourceManager() {
 	}
 }
 
+void ResourceManager::LRUList::pushFront(Resource *res) {
+	res->_lruPrev = NULL;
+	res->_lruNext = head;
+	if (head)
+		head->_lruPrev = res;
+	else
+		tail = res;
+	head = res;
+}
+
+void ResourceManager::LRUList::remove(Resource *res) {
+	if (res->_lruPrev)
+		res->_lruPrev->_lruNext = res->_lruNext;
+	else
+		head = res->_lruNext;
+
+	if (res->_lruNext)
+		res->_lruNext->_lruPrev = res->_lruPrev;
+	else
+		tail = res->_lruPrev;
+
+	res->_lruPrev = res->_lruNext = NULL;
+}
+
 void ResourceManager::removeFromLRU(Resource *res) {
 	if (res->_status != kResStatusEnqueued) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
-	_memoryLRU -= res->size;
+	if (res->_lruPinned) {
+		_pinnedLRU.remove(res);
+		_memoryPinned -= res->size;
+	} else {
+		_LRU.remove(res);
+		_memoryLRU -= res->size;
+	}
 	res->_status = kResStatusAllocated;
 }
 
@@ -1004,8 +1052,14 @@ void ResourceManager::addToLRU(Resource *res) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
-	_memoryLRU += res->size;
+	res->_lruPinned = _pinnedTypes[res->getType()];
+	if (res->_lruPinned) {
+		_pinnedLRU.pushFront(res);
+		_memoryPinned += res->size;
+	} else {
+		_LRU.pushFront(res);
+		_memoryLRU += res->size;
+	}
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s.%03d (%d bytes) to lru control: %d bytes total",
 	      getResourceTypeName(res->type), res->number, res->size,
@@ -1017,32 +1071,159 @@ void ResourceManager::addToLRU(Resource *res) {
 void ResourceManager::printLRU() {
 	int mem = 0;
 	int entries = 0;
-	Common::List<Resource *>::iterator it = _LRU.begin();
 	Resource *res;
 
-	while (it != _LRU.end()) {
-		res = *it;
+	for (res = _LRU.head; res; res = res->_lruNext) {
 		debug("\t%s: %d bytes", res->_id.toString().c_str(), res->size);
 		mem += res->size;
 		++entries;
-		++it;
 	}
 
 	debug("Total: %d entries, %d bytes (mgr says %d)", entries, mem, _memoryLRU);
+
+	if (_pinnedLRU.head) {
+		debug("Pinned:");
+		for (res = _pinnedLRU.head; res; res = res->_lruNext)
+			debug("\t%s: %d bytes", res->_id.toString().c_str(), res->size);
+		debug("Total: %d bytes", _memoryPinned);
+	}
 }
 
 void ResourceManager::freeOldResources() {
-	while (MAX_MEMORY < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = *_LRU.reverse_begin();
+	while (_maxMemoryLRU < _memoryLRU) {
+		assert(_LRU.tail);
+		Resource *goner = _LRU.tail;
 		removeFromLRU(goner);
 		goner->unalloc();
+		_typeStats[goner->getType()].evictions++;
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s.%03d (%d bytes)", getResourceTypeName(goner->type), goner->number, goner->size);
 #endif
 	}
 }
 
+void ResourceManager::setMaxMemoryLRU(int bytes) {
+	_maxMemoryLRU = bytes;
+	freeOldResources();
+}
+
+void ResourceManager::setResourceTypePinned(ResourceType type, bool pinned) {
+	if (_pinnedTypes[type] == pinned)
+		return;
+
+	_pinnedTypes[type] = pinned;
+
+	// Move the already queued resources of this type to the other list
+	LRUList &from = pinned ? _LRU : _pinnedLRU;
+	Resource *res = from.tail;
+	while (res) {
+		Resource *prev = res->_lruPrev;
+		if (res->getType() == type) {
+			removeFromLRU(res);
+			addToLRU(res);
+		}
+		res = prev;
+	}
+
+	freeOldResources();
+}
+
+void ResourceManager::resetTypeStats() {
+	memset(_typeStats, 0, sizeof(_typeStats));
+}
+
+void ResourceManager::setCurrentRoom(uint16 roomNumber) {
+	if (!_prefetchEnabled || roomNumber == _currentRoom)
+		return;
+
+	if (_currentRoom != kNoRoom) {
+		Common::Array<uint16> &successors = _roomSuccessors[_currentRoom];
+		bool known = false;
+		for (uint i = 0; i < successors.size(); i++) {
+			if (successors[i] == roomNumber) {
+				known = true;
+				break;
+			}
+		}
+		if (!known && successors.size() < kMaxRoomSuccessors)
+			successors.push_back(roomNumber);
+	}
+
+	_currentRoom = roomNumber;
+	_prefetchQueue.clear();
+
+	RoomSuccessorMap::const_iterator successors = _roomSuccessors.find(roomNumber);
+	if (successors == _roomSuccessors.end())
+		return;
+
+	for (uint i = 0; i < successors->_value.size(); i++) {
+		RoomResourceMap::const_iterator resources = _roomResources.find(successors->_value[i]);
+		if (resources == _roomResources.end())
+			continue;
+
+		for (uint j = 0; j < resources->_value.size(); j++)
+			_prefetchQueue.push_back(resources->_value[j]);
+	}
+
+	debugC(kDebugLevelResMan, 2, "[resMan] Entered room %d, %d resources queued for prefetching", roomNumber, _prefetchQueue.size());
+}
+
+void ResourceManager::recordRoomResource(ResourceId id) {
+	switch (id.getType()) {
+	case kResourceTypeView:
+	case kResourceTypePic:
+	case kResourceTypeScript:
+	case kResourceTypeHeap:
+		break;
+	default:
+		return;
+	}
+
+	Common::Array<ResourceId> &resources = _roomResources[_currentRoom];
+	if (resources.size() >= kMaxRoomResources)
+		return;
+
+	for (uint i = 0; i < resources.size(); i++) {
+		if (resources[i] == id)
+			return;
+	}
+
+	resources.push_back(id);
+}
+
+bool ResourceManager::prefetchResources(uint32 deadline) {
+	bool loaded = false;
+
+	while (!_prefetchQueue.empty() && (int32)(deadline - g_system->getMillis()) > 0) {
+		Resource *res = testResource(_prefetchQueue.front());
+		_prefetchQueue.pop_front();
+
+		if (!res || res->_status != kResStatusNoMalloc)
+			continue;
+
+		bool pinned = _pinnedTypes[res->getType()];
+		if (!pinned && _memoryLRU + (int)res->size > _maxMemoryLRU)
+			continue;
+
+		loadResource(res);
+		if (res->_status != kResStatusAllocated)
+			continue;
+
+		// The size is not always known before the resource is loaded. Never
+		// push out resources that are in use for one that may not be needed.
+		if (!pinned && _memoryLRU + (int)res->size > _maxMemoryLRU) {
+			res->unalloc();
+			continue;
+		}
+
+		addToLRU(res);
+		_typeStats[res->getType()].prefetches++;
+		loaded = true;
+	}
+
+	return loaded;
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -1062,10 +1243,16 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
+	if (retval->_status == kResStatusNoMalloc) {
+		_typeStats[retval->getType()].misses++;
+		if (_currentRoom != kNoRoom)
+			recordRoomResource(id);
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
-		removeFromLRU(retval);
+	} else {
+		_typeStats[retval->getType()].hits++;
+		if (retval->_status == kResStatusEnqueued)
+			removeFromLRU(retval);
+	}
 	// Unless an error occurred, the resource is now either
 	// locked or allocated, but never queued or freed.
 
@@ -1853,6 +2040,8 @@ Resource *ResourceManager::updateResource(ResourceId resId, ResourceSource *src,
 
 	if (_resMap.contains(resId)) {
 		res = _resMap.getVal(resId);
+		if (res->_status == kResStatusEnqueued)
+			removeFromLRU(res);
 	} else {
 		res = new Resource(this, resId);
 		_resMap.setVal(resId, res);
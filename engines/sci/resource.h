@@ -24,6 +24,7 @@
 #define SCI_RESOURCE_H
 
 #include "common/str.h"
+#include "common/array.h"
 #include "common/list.h"
 #include "common/hashmap.h"
 
@@ -242,6 +243,9 @@ protected:
 	uint16 _lockers; /**< Number of places where this resource was locked */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
+	Resource *_lruPrev; /**< Next more recently used resource in the LRU list */
+	Resource *_lruNext; /**< Next less recently used resource in the LRU list */
+	bool _lruPinned; /**< Whether the resource is queued in the pinned list */
 
 	bool loadPatch(Common::SeekableReadStream *file);
 	bool loadFromPatchFile();
@@ -378,8 +382,62 @@ public:
 	 */
 	ResourceType convertResType(byte type);
 
+	/** Cache statistics of a single resource type */
+	struct TypeStats {
+		uint32 hits;		///< Lookups served from memory
+		uint32 misses;		///< Lookups which had to load the resource
+		uint32 evictions;	///< Resources of this type freed by the LRU
+		uint32 prefetches;	///< Resources of this type loaded ahead of time
+	};
+
+	const TypeStats &getTypeStats(ResourceType type) const { return _typeStats[type]; }
+	void resetTypeStats();
+
+	int getMemoryLocked() const { return _memoryLocked; }
+	int getMemoryLRU() const { return _memoryLRU; }
+	int getMemoryPinned() const { return _memoryPinned; }
+	int getMaxMemoryLRU() const { return _maxMemoryLRU; }
+
+	/**
+	 * Sets the amount of memory unlocked resources may use before the least
+	 * recently used ones are freed.
+	 */
+	void setMaxMemoryLRU(int bytes);
+
+	/**
+	 * Pins or unpins a resource type. Unlocked resources of pinned types stay
+	 * in memory instead of being freed by the LRU, and do not count towards
+	 * its memory budget.
+	 */
+	void setResourceTypePinned(ResourceType type, bool pinned);
+	bool isResourceTypePinned(ResourceType type) const { return _pinnedTypes[type]; }
+
+	void printLRU();
+
+	/**
+	 * Tells the resource manager which room the game is in. The resources
+	 * loaded in each room are remembered, and when a room is entered, the
+	 * ones used by the rooms which were previously reached from it are
+	 * queued for prefetching.
+	 */
+	void setCurrentRoom(uint16 roomNumber);
+
+	/**
+	 * Loads queued prefetch resources into the LRU until the given time (as
+	 * returned by OSystem::getMillis()) is reached. Meant to be called while
+	 * the engine would otherwise sleep. Prefetching never evicts resources.
+	 *
+	 * This runs on the engine thread because loading a resource isn't safe
+	 * to do concurrently: it shares the open volume files (and their seek
+	 * positions) in _volumeFiles with the game's own loads, and it updates
+	 * the LRU and the resource map, which the game reads unlocked.
+	 * @return true if any resource was loaded
+	 */
+	bool prefetchResources(uint32 deadline);
+
 protected:
-	// Maximum number of bytes to allow being allocated for resources
+	// Default number of bytes to allow being allocated for resources. Can be
+	// overridden with the "resource_cache_size" config key (in KB).
 	// Note: maxMemory will not be interpreted as a hard limit, only as a restriction
 	// for resources which are not explicitly locked. However, a warning will be
 	// issued whenever this limit is exceeded.
@@ -387,11 +445,50 @@ protected:
 		MAX_MEMORY = 256 * 1024	// 256KB
 	};
 
+	/**
+	 * Intrusive list of resources, linked through Resource::_lruPrev and
+	 * Resource::_lruNext. The most recently used resource is at the head.
+	 */
+	struct LRUList {
+		Resource *head;
+		Resource *tail;
+
+		void clear() { head = tail = 0; }
+		void pushFront(Resource *res);
+		void remove(Resource *res);
+	};
+
 	ViewType _viewType; // Used to determine if the game has EGA or VGA graphics
 	Common::List<ResourceSource *> _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	int _memoryPinned;	///< Amount of resource bytes of pinned types kept around unlocked
+	int _maxMemoryLRU;	///< Amount of resource bytes the LRU may keep around
+	LRUList _LRU; ///< Last Resource Used list
+	LRUList _pinnedLRU; ///< Unlocked resources of pinned types
+	bool _pinnedTypes[kResourceTypeInvalid];
+	TypeStats _typeStats[kResourceTypeInvalid];
+
+	// Room tracking, used to prefetch the resources of the rooms the player
+	// is likely to enter next (see setCurrentRoom)
+	enum {
+		kNoRoom = 0xFFFF,
+		kMaxRoomResources = 64,	///< Max. number of resources remembered per room
+		kMaxRoomSuccessors = 8	///< Max. number of rooms remembered as reached from a room
+	};
+
+	typedef Common::HashMap<uint16, Common::Array<ResourceId> > RoomResourceMap;
+	typedef Common::HashMap<uint16, Common::Array<uint16> > RoomSuccessorMap;
+
+	bool _prefetchEnabled;	///< Set by the "resource_prefetch" config key
+	uint16 _currentRoom;	///< Room the game is currently in, or kNoRoom
+	RoomResourceMap _roomResources;		///< Resources loaded while in each room
+	RoomSuccessorMap _roomSuccessors;	///< Rooms entered from each room
+	Common::List<ResourceId> _prefetchQueue;	///< Resources still to be prefetched
+
+	/** Remembers that the given resource was loaded in the current room. */
+	void recordRoomResource(ResourceId id);
+
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -508,7 +605,6 @@ protected:
 	 */
 	bool hasOldScriptHeader();
 
-	void printLRU();
 	void addToLRU(Resource *res);
 	void removeFromLRU(Resource *res);
 
@@ -552,6 +552,11 @@ bool SciEngine::initGame() {
 	_gamestate->_msgState = new MessageState(_gamestate->_segMan);
 	_gamestate->gcCountDown = GC_INTERVAL - 1;
 
+	// When restarting, objects queued by the gc refer to the segments of the
+	// previous run, which have been freed and may have been reused since
+	_gamestate->gcPendingFrees.clear();
+	memset(&_gamestate->gcStatistics, 0, sizeof(_gamestate->gcStatistics));
+
 	// Script 0 should always be at segment 1
 	if (script0Segment != 1) {
 		debug(2, "Failed to instantiate script.000");
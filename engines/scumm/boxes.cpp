@@ -952,8 +952,10 @@ static void printMatrix2(byte *matrix, int num) {
 /**
  * Computes shortest paths and stores them in the itinerary matrix.
  * Parameter "num" holds the number of rows (= number of columns).
+ * If "neighbors" is given, it holds whether two boxes are neighbors
+ * (with "num" columns), instead of calling areBoxesNeighbors().
  */
-void ScummEngine::calcItineraryMatrix(byte *itineraryMatrix, int num) {
+void ScummEngine::calcItineraryMatrix(byte *itineraryMatrix, int num, const byte *neighbors) {
 	int i, j, k;
 	byte *adjacentMatrix;
 
@@ -970,7 +972,7 @@ void ScummEngine::calcItineraryMatrix(byte *itineraryMatrix, int num) {
 			if (i == j) {
 				adjacentMatrix[i * boxSize + j] = 0;
 				itineraryMatrix[i * boxSize + j] = j;
-			} else if (areBoxesNeighbors(i, j)) {
+			} else if (neighbors ? neighbors[i * num + j] : areBoxesNeighbors(i, j)) {
 				adjacentMatrix[i * boxSize + j] = 1;
 				itineraryMatrix[i * boxSize + j] = j;
 			} else {
@@ -1005,6 +1007,33 @@ void ScummEngine::calcItineraryMatrix(byte *itineraryMatrix, int num) {
 	free(adjacentMatrix);
 }
 
+void ScummEngine::updateBoxMatrixCache(int num) {
+	assert(num <= BoxMatrixCache::kMaxBoxes);
+
+	bool changed = (num != (int)_boxMatrixCache.coords.size());
+	if (changed)
+		_boxMatrixCache.coords.resize(num);
+
+	for (int i = 0; i < num; i++) {
+		const BoxCoords box = getBoxCoordinates(i);
+		BoxCoords &cached = _boxMatrixCache.coords[i];
+		if (cached.ul != box.ul || cached.ur != box.ur || cached.ll != box.ll || cached.lr != box.lr) {
+			cached = box;
+			changed = true;
+		}
+	}
+
+	// The walkboxes were changed, e.g. by entering another room, so any
+	// previously computed box matrix is of no use anymore
+	if (changed) {
+		debug(5, "Box geometry changed, recomputing which of %d boxes touch", num);
+		_boxMatrixCache.matrices.clear();
+		for (int i = 0; i < num; i++)
+			for (int j = 0; j < num; j++)
+				_boxMatrixCache.touching[i * num + j] = (i != j) && doBoxesTouch(_boxMatrixCache.coords[j], _boxMatrixCache.coords[i]);
+	}
+}
+
 void ScummEngine::createBoxMatrix() {
 	int num, i, j;
 
@@ -1013,9 +1042,48 @@ void ScummEngine::createBoxMatrix() {
 
 	const uint8 boxSize = (_game.version == 0) ? num : 64;
 
+	// The box matrix only depends on the box geometry and on which boxes
+	// are invisible, so reuse a previously computed one if possible. Scripts
+	// often recreate the matrix after changing other box flags, or toggle
+	// the same boxes back and forth.
+	updateBoxMatrixCache(num);
+
+	uint64 invisibleBoxes = 0;
+	for (i = 0; i < num; i++) {
+		if (getBoxFlags(i) & kBoxInvisible)
+			invisibleBoxes |= (uint64)1 << i;
+	}
+
+	Common::List<BoxMatrixCache::Matrix>::iterator it;
+	for (it = _boxMatrixCache.matrices.begin(); it != _boxMatrixCache.matrices.end(); ++it) {
+		if (it->invisibleBoxes == invisibleBoxes) {
+			byte *matrix = _res->createResource(rtMatrix, 1, BOX_MATRIX_SIZE);
+			memcpy(matrix, it->data.begin(), it->data.size());
+
+			// Move the matrix to the front of the list
+			if (it != _boxMatrixCache.matrices.begin()) {
+				_boxMatrixCache.matrices.push_front(*it);
+				_boxMatrixCache.matrices.erase(it);
+			}
+
+			_boxMatrixCache.numReused++;
+			return;
+		}
+	}
+
+	_boxMatrixCache.numRebuilds++;
+	debug(5, "Computing box matrix for %d boxes (%d times so far)", num, _boxMatrixCache.numRebuilds);
+
+	byte *neighbors = (byte *)malloc(num * num);
+	for (i = 0; i < num; i++) {
+		for (j = 0; j < num; j++)
+			neighbors[i * num + j] = _boxMatrixCache.touching[i * num + j] && !(invisibleBoxes & (((uint64)1 << i) | ((uint64)1 << j)));
+	}
+
 	// calculate shortest paths
 	byte *itineraryMatrix = (byte *)malloc(boxSize * boxSize);
-	calcItineraryMatrix(itineraryMatrix, num);
+	calcItineraryMatrix(itineraryMatrix, num, neighbors);
+	free(neighbors);
 
 	// "Compress" the distance matrix into the box matrix format used
 	// by the engine. The format is like this:
@@ -1030,6 +1098,7 @@ void ScummEngine::createBoxMatrix() {
 	// See also getNextBox.
 
 	byte *matrixStart = _res->createResource(rtMatrix, 1, BOX_MATRIX_SIZE);
+	const byte *matrixBegin = matrixStart;
 	const byte *matrixEnd = matrixStart + BOX_MATRIX_SIZE;
 
 	#define addToMatrix(b)	do { *matrixStart++ = (b); assert(matrixStart < matrixEnd); } while (0)
@@ -1049,6 +1118,13 @@ void ScummEngine::createBoxMatrix() {
 	}
 	addToMatrix(0xFF);
 
+	// Remember the new matrix, forgetting the least recently used one
+	if (_boxMatrixCache.matrices.size() >= BoxMatrixCache::kMaxMatrices)
+		_boxMatrixCache.matrices.pop_back();
+	_boxMatrixCache.matrices.push_front(BoxMatrixCache::Matrix());
+	_boxMatrixCache.matrices.front().invisibleBoxes = invisibleBoxes;
+	_boxMatrixCache.matrices.front().data.resize(matrixStart - matrixBegin);
+	memcpy(_boxMatrixCache.matrices.front().data.begin(), matrixBegin, matrixStart - matrixBegin);
 
 #if BOX_DEBUG
 	debug("Itinerary matrix:\n");
@@ -1062,16 +1138,15 @@ void ScummEngine::createBoxMatrix() {
 
 /** Check if two boxes are neighbors. */
 bool ScummEngine::areBoxesNeighbors(int box1nr, int box2nr) {
-	Common::Point tmp;
-	BoxCoords box;
-	BoxCoords box2;
-
 	if ((getBoxFlags(box1nr) & kBoxInvisible) || (getBoxFlags(box2nr) & kBoxInvisible))
 		return false;
 
 	assert(_game.version >= 3);
-	box2 = getBoxCoordinates(box1nr);
-	box = getBoxCoordinates(box2nr);
+	return doBoxesTouch(getBoxCoordinates(box2nr), getBoxCoordinates(box1nr));
+}
+
+bool ScummEngine::doBoxesTouch(BoxCoords box, BoxCoords box2) const {
+	Common::Point tmp;
 
 	// Roughly, the idea of this algorithm is to search for sies of the given
 	// boxes that touch each other.
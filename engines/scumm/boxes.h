@@ -23,6 +23,8 @@
 #ifndef SCUMM_BOXES_H
 #define SCUMM_BOXES_H
 
+#include "common/array.h"
+#include "common/list.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -51,6 +53,39 @@ struct BoxCoords {			/* Box coordinates */
 
 int getClosestPtOnBox(const BoxCoords &box, int x, int y, int16& outX, int16& outY);
 
+/**
+ * Which walkboxes of the current room touch each other, and the box
+ * matrices computed from that, so that scripts which toggle box flags and
+ * recreate the box matrix don't redo the same work over and over again.
+ */
+struct BoxMatrixCache {
+	enum {
+		kMaxBoxes = 64,
+		kMaxMatrices = 8
+	};
+
+	/** A box matrix, for the given set of invisible boxes. */
+	struct Matrix {
+		uint64 invisibleBoxes;
+		Common::Array<byte> data;
+	};
+
+	/** The box coordinates for which touching was computed. */
+	Common::Array<BoxCoords> coords;
+
+	/** Whether two boxes share a side, regardless of their flags. */
+	byte touching[kMaxBoxes * kMaxBoxes];
+
+	/** The most recently used box matrices, most recent first. */
+	Common::List<Matrix> matrices;
+
+	/** Statistics, for the debugger. */
+	uint32 numRebuilds;
+	uint32 numReused;
+
+	BoxMatrixCache() : numRebuilds(0), numReused(0) {}
+};
+
 } // End of namespace Scumm
 
 #endif
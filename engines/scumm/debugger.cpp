@@ -79,6 +79,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	DCmd_Register("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	DCmd_Register("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
 	DCmd_Register("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
+	DCmd_Register("resources", WRAP_METHOD(ScummDebugger, Cmd_PrintResources));
 
 	if (_vm->_game.id == GID_LOOM)
 		DCmd_Register("drafts",  WRAP_METHOD(ScummDebugger, Cmd_PrintDraft));
@@ -311,6 +312,43 @@ bool ScummDebugger::Cmd_ImportRes(int argc, const char** argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_PrintResources(int argc, const char **argv) {
+	ResourceManager *res = _vm->_res;
+
+	if (argc > 1 && !strcmp(argv[1], "log")) {
+		DebugPrintf("Last expired resources, oldest first:\n");
+		Common::List<ResourceManager::ExpiredResource>::const_iterator it;
+		for (it = res->_expireLog.begin(); it != res->_expireLog.end(); ++it)
+			DebugPrintf("  %-12s %4d  size %7d  counter %3d\n", nameOfResType(it->type), it->idx, it->size, it->counter);
+		return true;
+	} else if (argc > 1) {
+		DebugPrintf("Syntax: resources [log]\n");
+		return true;
+	}
+
+	DebugPrintf("+------------+------+----------+--------+\n");
+	DebugPrintf("|type        |loaded|      size|  locked|\n");
+	DebugPrintf("+------------+------+----------+--------+\n");
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		uint32 loadedNum = 0, loadedSize = 0, lockedNum = 0;
+		for (ResId idx = 0; idx < res->_types[type].size(); idx++) {
+			if (res->_types[type][idx]._address) {
+				loadedNum++;
+				loadedSize += res->_types[type][idx]._size;
+				if (res->_types[type][idx].isLocked())
+					lockedNum++;
+			}
+		}
+		if (loadedNum)
+			DebugPrintf("|%-12s|%6d|%10d|%8d|\n", nameOfResType(type), loadedNum, loadedSize, lockedNum);
+	}
+	DebugPrintf("+------------+------+----------+--------+\n");
+
+	DebugPrintf("Heap: %d bytes allocated, expiring from %d down to %d bytes\n", res->_allocatedSize, res->_maxHeapThreshold, res->_minHeapThreshold);
+	DebugPrintf("Expired: %d resources (%d bytes), %d of them reloaded\n", res->_expiredNum, res->_expiredSize, res->_reloadedNum);
+	return true;
+}
+
 bool ScummDebugger::Cmd_PrintScript(int argc, const char **argv) {
 	int i;
 	ScriptSlot *ss = _vm->vm.slot;
@@ -589,6 +627,8 @@ bool ScummDebugger::Cmd_PrintBoxMatrix(int argc, const char **argv) {
 		}
 		DebugPrintf("\n");
 	}
+	if (_vm->_game.version >= 3)
+		DebugPrintf("Box matrix computed %d times, reused %d times\n", _vm->_boxMatrixCache.numRebuilds, _vm->_boxMatrixCache.numReused);
 	return true;
 }
 
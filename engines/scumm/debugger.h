@@ -53,6 +53,7 @@ private:
 	bool Cmd_Script(int argc, const char **argv);
 	bool Cmd_PrintScript(int argc, const char **argv);
 	bool Cmd_ImportRes(int argc, const char **argv);
+	bool Cmd_PrintResources(int argc, const char **argv);
 
 	bool Cmd_PrintDraft(int argc, const char **argv);
 	bool Cmd_Passcode(int argc, const char **argv);
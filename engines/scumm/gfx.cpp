@@ -19,7 +19,9 @@
  *
  */
 
+#include "common/config-manager.h"
 #include "common/system.h"
+#include "graphics/conversion.h"
 #include "scumm/actor.h"
 #include "scumm/charset.h"
 #ifdef ENABLE_HE
@@ -214,6 +216,13 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+
+	// Decided in init(), once the subclass is known
+	_stripCache.enabled = false;
+	_stripCache.ptr = 0;
+	_stripCache.height = 0;
+	_stripCache.numZBuffer = 0;
+	_stripCache.bytesPerPixel = 0;
 }
 
 Gdi::~Gdi() {
@@ -259,6 +268,9 @@ GdiHE16bit::GdiHE16bit(ScummEngine *vm) : GdiHE(vm) {
 void Gdi::init() {
 	_numStrips = _vm->_screenWidth / 8;
 
+	_stripCache.enabled = stripCacheSupported() &&
+		(!ConfMan.hasKey("strip_cache") || ConfMan.getBool("strip_cache"));
+
 	// Increase the number of screen strips by one; needed for smooth scrolling
 	if (_vm->_game.version >= 7) {
 		// We now have mostly working smooth scrolling code in place for V7+ games
@@ -274,14 +286,19 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	clearStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
+	Gdi::roomChanged(roomptr);
+
 	decodeNESGfx(roomptr);
 }
 
 #ifdef USE_RGB_COLOR
 void GdiPCEngine::roomChanged(byte *roomptr) {
+	Gdi::roomChanged(roomptr);
+
 	decodePCEngineGfx(roomptr);
 }
 #endif
@@ -296,6 +313,8 @@ void GdiPCEngine::loadTiles(byte *roomptr) {
 #endif
 
 void GdiV1::roomChanged(byte *roomptr) {
+	Gdi::roomChanged(roomptr);
+
 	for (int i = 0; i < 4; i++){
 		_V1.colors[i] = roomptr[6 + i];
 	}
@@ -312,6 +331,8 @@ void GdiV1::roomChanged(byte *roomptr) {
 }
 
 void GdiV2::roomChanged(byte *roomptr) {
+	Gdi::roomChanged(roomptr);
+
 	_roomStrips = generateStripTable(roomptr + READ_LE_UINT16(roomptr + 0x0A),
 			_vm->_roomWidth, _vm->_roomHeight, _roomStrips);
 }
@@ -684,36 +705,8 @@ void ScummEngine::drawStripToScreen(VirtScreen *vs, int x, int width, int top, i
 #ifdef USE_ARM_GFX_ASM
 			asmDrawStripToScreen(height, width, text, src, _compositeBuf, vs->pitch, width, _textSurface.pitch);
 #else
-			// We blit four pixels at a time, for improved performance.
-			const uint32 *src32 = (const uint32 *)src;
-			uint32 *dst32 = (uint32 *)_compositeBuf;
-
-			vsPitch >>= 2;
-
-			const uint32 *text32 = (const uint32 *)text;
-			const int textPitch = (_textSurface.pitch - width * m) >> 2;
-			for (int h = height * m; h > 0; --h) {
-				for (int w = width * m; w > 0; w -= 4) {
-					uint32 temp = *text32++;
-
-					// Generate a byte mask for those text pixels (bytes) with
-					// value CHARSET_MASK_TRANSPARENCY. In the end, each byte
-					// in mask will be either equal to 0x00 or 0xFF.
-					// Doing it this way avoids branches and bytewise operations,
-					// at the cost of readability ;).
-					uint32 mask = temp ^ CHARSET_MASK_TRANSPARENCY_32;
-					mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
-					mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
-
-					// The following line is equivalent to this code:
-					//   *dst32++ = (*src32++ & mask) | (temp & ~mask);
-					// However, some compilers can generate somewhat better
-					// machine code for this equivalent statement:
-					*dst32++ = ((temp ^ *src32++) & mask) ^ temp;
-				}
-				src32 += vsPitch;
-				text32 += textPitch;
-			}
+			Graphics::keyComposite(_compositeBuf, width * m, (const byte *)src, vsPitch + width * m,
+			                       (const byte *)text, _textSurface.pitch, width * m, height * m, CHARSET_MASK_TRANSPARENCY);
 #endif
 		}
 		src = _compositeBuf;
@@ -786,7 +779,7 @@ static const byte cgaDither[2][2][16] = {
 // But apparently there is a mistake for 10th color.
 void ScummEngine::ditherCGA(byte *dst, int dstPitch, int x, int y, int width, int height) const {
 	byte *ptr;
-	int idx1, idx2;
+	int idx1;
 
 	for (int y1 = 0; y1 < height; y1++) {
 		ptr = dst + y1 * dstPitch;
@@ -796,11 +789,7 @@ void ScummEngine::ditherCGA(byte *dst, int dstPitch, int x, int y, int width, in
 		else
 			idx1 = (y + y1) % 2;
 
-		for (int x1 = 0; x1 < width; x1++) {
-			idx2 = (x + x1) % 2;
-			*ptr = cgaDither[idx1][idx2][*ptr & 0xF];
-			ptr++;
-		}
+		Graphics::lookupNibbles(ptr, ptr, width, cgaDither[idx1][x % 2], cgaDither[idx1][(x + 1) % 2]);
 	}
 }
 
@@ -825,13 +814,7 @@ void ditherHerc(byte *src, byte *hercbuf, int srcPitch, int *x, int *y, int *wid
 		dstptr = hercbuf + dsty * kHercWidth + xo * 2;
 
 		const int idx1 = (dsty % 7) % 2;
-		for (int x1 = 0; x1 < widtho; x1++) {
-			const int idx2 = (xo + x1) % 2;
-			const byte tmp = cgaDither[idx1][idx2][*srcptr & 0xF];
-			*dstptr++ = tmp >> 1;
-			*dstptr++ = tmp & 0x1;
-			srcptr++;
-		}
+		Graphics::lookupNibblesToBits(dstptr, srcptr, widtho, cgaDither[idx1][xo % 2], cgaDither[idx1][(xo + 1) % 2]);
 		if (idx1 || dsty % 7 == 6)
 			y1++;
 		dsty++;
@@ -1007,7 +990,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbCacheStrips);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -1797,6 +1780,9 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	const bool useStripCache = (flag & dbCacheStrips) && y == 0 && prepareStripCache(ptr, vs, height, numzbuf);
+	const int stripSize = 8 * height * vs->format.bytesPerPixel;
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -1829,7 +1815,16 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->pixels + y * vs->pitch + (x * 8 * vs->format.bytesPerPixel);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		const bool cacheStrip = useStripCache && stripnr < (int)_stripCache.valid.size();
+		const bool cachedStrip = cacheStrip && _stripCache.valid[stripnr];
+
+		if (cachedStrip) {
+			const byte *src = &_stripCache.pixels[stripnr * stripSize];
+			for (int h = 0; h < height; h++)
+				memcpy(dstPtr + h * vs->pitch, src + h * 8 * vs->format.bytesPerPixel, 8 * vs->format.bytesPerPixel);
+		} else {
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		}
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -1843,7 +1838,40 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		// The masks of the background don't depend on transpStrip, since
+		// dbAllowMaskOr is never used for it. Z-planes missing from the room
+		// are left alone by decodeMask(), so they are not cached either.
+		if (cachedStrip) {
+			for (int i = 1; i < numzbuf; i++) {
+				if (!zplane_list[i])
+					continue;
+
+				const byte *src = &_stripCache.masks[(stripnr * numzbuf + i) * height];
+				byte *mask_ptr = getMaskBuffer(x, y, i);
+				for (int h = 0; h < height; h++)
+					mask_ptr[h * _numStrips] = src[h];
+			}
+		} else {
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+			if (cacheStrip) {
+				byte *dst = &_stripCache.pixels[stripnr * stripSize];
+				for (int h = 0; h < height; h++)
+					memcpy(dst + h * 8 * vs->format.bytesPerPixel, dstPtr + h * vs->pitch, 8 * vs->format.bytesPerPixel);
+
+				for (int i = 1; i < numzbuf; i++) {
+					if (!zplane_list[i])
+						continue;
+
+					const byte *mask_ptr = getMaskBuffer(x, y, i);
+					dst = &_stripCache.masks[(stripnr * numzbuf + i) * height];
+					for (int h = 0; h < height; h++)
+						dst[h] = mask_ptr[h * _numStrips];
+				}
+
+				_stripCache.valid[stripnr] = true;
+			}
+		}
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -1871,6 +1899,39 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	}
 }
 
+bool Gdi::prepareStripCache(const byte *ptr, VirtScreen *vs, int height, int numzbuf) {
+	if (!_stripCache.enabled || vs->number != kMainVirtScreen)
+		return false;
+
+	// The decoded colors depend on the room palette, which scripts may change
+	if (_stripCache.ptr != ptr || _stripCache.height != height || _stripCache.numZBuffer != numzbuf ||
+			_stripCache.bytesPerPixel != vs->format.bytesPerPixel || memcmp(_stripCache.roomPalette, _vm->_roomPalette, 256)) {
+		const int numRoomStrips = _vm->_roomWidth / 8;
+
+		_stripCache.ptr = ptr;
+		_stripCache.height = height;
+		_stripCache.numZBuffer = numzbuf;
+		_stripCache.bytesPerPixel = vs->format.bytesPerPixel;
+		memcpy(_stripCache.roomPalette, _vm->_roomPalette, 256);
+
+		_stripCache.valid.clear();
+		_stripCache.valid.resize(numRoomStrips);
+		for (int i = 0; i < numRoomStrips; i++)
+			_stripCache.valid[i] = false;
+		_stripCache.pixels.resize(numRoomStrips * 8 * height * vs->format.bytesPerPixel);
+		_stripCache.masks.resize(numRoomStrips * numzbuf * height);
+	}
+
+	return true;
+}
+
+void Gdi::clearStripCache() {
+	_stripCache.ptr = 0;
+	_stripCache.valid.clear();
+	_stripCache.pixels.clear();
+	_stripCache.masks.clear();
+}
+
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
 	// Do some input verification and make sure the strip/strip offset
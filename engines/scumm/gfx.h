@@ -23,6 +23,7 @@
 #ifndef SCUMM_GFX_H
 #define SCUMM_GFX_H
 
+#include "common/array.h"
 #include "common/system.h"
 #include "common/list.h"
 
@@ -197,6 +198,33 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * The decoded strips of the room background, with their z-plane masks.
+	 * Each strip is decoded only once per room, so scrolling back and forth
+	 * doesn't decode the same strips over and over again.
+	 */
+	struct StripCache {
+		bool enabled;
+		const byte *ptr;
+		int height;
+		int numZBuffer;
+		int bytesPerPixel;
+		byte roomPalette[256];
+		Common::Array<bool> valid;
+		Common::Array<byte> pixels;
+		Common::Array<byte> masks;
+	} _stripCache;
+
+	bool prepareStripCache(const byte *ptr, VirtScreen *vs, int height, int numzbuf);
+	void clearStripCache();
+
+	/**
+	 * Whether the strip cache may be used. The cache stores what the strip
+	 * and mask decoders of Gdi produce, so subclasses which replace
+	 * drawStrip() or decodeMask() have to return false.
+	 */
+	virtual bool stripCacheSupported() const { return true; }
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -270,7 +298,8 @@ public:
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbObjectMode    = 2 << 2,
+		dbCacheStrips   = 1 << 4	///< Drawing the room background, whose strips may be cached
 	};
 };
 
@@ -285,6 +314,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag);
 
+	virtual bool stripCacheSupported() const { return false; }
+
 	virtual void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
@@ -317,6 +348,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag);
 
+	virtual bool stripCacheSupported() const { return false; }
+
 	virtual void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
@@ -360,6 +393,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag);
 
+	virtual bool stripCacheSupported() const { return false; }
+
 	virtual void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
@@ -397,6 +432,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag);
 
+	virtual bool stripCacheSupported() const { return false; }
+
 	virtual void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
@@ -423,6 +460,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag);
 
+	virtual bool stripCacheSupported() const { return false; }
+
 	virtual void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
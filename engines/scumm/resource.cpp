@@ -20,6 +20,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/str.h"
 #ifndef MACOSX
 #include "common/config-manager.h"
@@ -48,12 +49,15 @@ enum {
 	RF_USAGE_MAX = RF_USAGE,
 
 	RS_MODIFIED = 0x10,
+	RS_EXPIRED = 0x20,
 	RF_OFFHEAP = 0x40
 };
 
+enum {
+	EXPIRE_LOG_SIZE = 32	// Number of expired resources remembered for the debugger
+};
 
 
-extern const char *nameOfResType(ResType type);
 
 static uint16 newTag2Old(uint32 newTag);
 static const byte *findResourceSmall(uint32 tag, const byte *searchin);
@@ -746,7 +750,7 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 		return NULL;
 	}
 
-	_res->setResourceCounter(type, idx, 1);
+	_res->touchResource(type, idx);
 
 	debugC(DEBUG_RESOURCE, "getResourceAddress(%s,%d) == %p", nameOfResType(type), idx, ptr);
 	return ptr;
@@ -792,6 +796,11 @@ void ResourceManager::setResourceCounter(ResType type, ResId idx, byte counter)
 	_types[type][idx].setResourceCounter(counter);
 }
 
+void ResourceManager::touchResource(ResType type, ResId idx) {
+	_types[type][idx].setResourceCounter(1);
+	_types[type][idx]._lastUsed = ++_useCounter;
+}
+
 void ResourceManager::Resource::setResourceCounter(byte counter) {
 	_flags &= RF_LOCK;	// Clear lower 7 bits, preserve the lock bit.
 	_flags |= counter;	// Update the usage counter
@@ -831,9 +840,14 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 	memset(ptr, 0, size + SAFETY_AREA);
 	_allocatedSize += size;
 
+	if (_types[type][idx].isExpired()) {
+		_types[type][idx].setExpired(false);
+		_reloadedNum++;
+	}
+
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
-	setResourceCounter(type, idx, 1);
+	touchResource(type, idx);
 	return ptr;
 }
 
@@ -844,6 +858,7 @@ ResourceManager::Resource::Resource() {
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
+	_lastUsed = 0;
 }
 
 ResourceManager::Resource::~Resource() {
@@ -872,6 +887,10 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	_useCounter = 0;
+	_expiredNum = 0;
+	_expiredSize = 0;
+	_reloadedNum = 0;
 }
 
 ResourceManager::~ResourceManager() {
@@ -1032,10 +1051,33 @@ void ResourceManager::Resource::setOnHeap() {
 	_status &= ~RF_OFFHEAP;
 }
 
+void ResourceManager::Resource::setExpired(bool expired) {
+	if (expired)
+		_status |= RS_EXPIRED;
+	else
+		_status &= ~RS_EXPIRED;
+}
+
+bool ResourceManager::Resource::isExpired() const {
+	return (_status & RS_EXPIRED) != 0;
+}
+
+struct ExpireCandidate {
+	ResType type;
+	ResId idx;
+	byte counter;
+	uint32 lastUsed;
+};
+
+// The oldest resources are expired first, and among resources of the same
+// age the least recently used ones
+static bool compareExpireCandidates(const ExpireCandidate &a, const ExpireCandidate &b) {
+	if (a.counter != b.counter)
+		return a.counter > b.counter;
+	return a.lastUsed < b.lastUsed;
+}
+
 void ResourceManager::expireResources(uint32 size) {
-	byte best_counter;
-	ResType best_type;
-	int best_res = 0;
 	uint32 oldAllocatedSize;
 
 	if (_expireCounter != 0xFF) {
@@ -1048,31 +1090,44 @@ void ResourceManager::expireResources(uint32 size) {
 
 	oldAllocatedSize = _allocatedSize;
 
-	do {
-		best_type = rtInvalid;
-		best_counter = 2;
-
-		for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
-			if (_types[type]._mode != kDynamicResTypeMode) {
-				// Resources of this type can be reloaded from the data files,
-				// so we can potentially unload them to free memory.
-				ResId idx = _types[type].size();
-				while (idx-- > 0) {
-					Resource &tmp = _types[type][idx];
-					byte counter = tmp.getResourceCounter();
-					if (!tmp.isLocked() && counter >= best_counter && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
-						best_counter = counter;
-						best_type = type;
-						best_res = idx;
-					}
+	// Collect all the resources which can be expired in one go, instead
+	// of searching them again for every resource that is expired
+	Common::Array<ExpireCandidate> candidates;
+
+	for (ResType type = rtFirst; type <= rtLast; type = ResType(type + 1)) {
+		if (_types[type]._mode != kDynamicResTypeMode) {
+			// Resources of this type can be reloaded from the data files,
+			// so we can potentially unload them to free memory.
+			ResId idx = _types[type].size();
+			while (idx-- > 0) {
+				Resource &tmp = _types[type][idx];
+				byte counter = tmp.getResourceCounter();
+				if (!tmp.isLocked() && counter >= 2 && tmp._address && !_vm->isResourceInUse(type, idx) && !tmp.isOffHeap()) {
+					ExpireCandidate candidate = { type, idx, counter, tmp._lastUsed };
+					candidates.push_back(candidate);
 				}
 			}
 		}
+	}
 
-		if (!best_type)
-			break;
-		nukeResource(best_type, best_res);
-	} while (size + _allocatedSize > _minHeapThreshold);
+	Common::sort(candidates.begin(), candidates.end(), compareExpireCandidates);
+
+	for (uint i = 0; i < candidates.size() && size + _allocatedSize > _minHeapThreshold; i++) {
+		Resource &res = _types[candidates[i].type][candidates[i].idx];
+
+		debugC(DEBUG_RESOURCE, "Expiring %s %d, size %d, counter %d", nameOfResType(candidates[i].type), candidates[i].idx, res._size, candidates[i].counter);
+
+		ExpiredResource entry = { candidates[i].type, candidates[i].idx, res._size, candidates[i].counter };
+		_expireLog.push_back(entry);
+		if (_expireLog.size() > EXPIRE_LOG_SIZE)
+			_expireLog.pop_front();
+
+		_expiredNum++;
+		_expiredSize += res._size;
+
+		nukeResource(candidates[i].type, candidates[i].idx);
+		res.setExpired(true);
+	}
 
 	increaseResourceCounters();
 
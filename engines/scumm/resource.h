@@ -23,6 +23,7 @@
 #define SCUMM_RESOURCE_H
 
 #include "common/array.h"
+#include "common/list.h"
 #include "scumm/scumm.h"	// for ResType
 
 namespace Scumm {
@@ -73,7 +74,7 @@ enum ResTypeMode {
  * a 'class', at least until somebody gets around to OOfying this more.
  */
 class ResourceManager {
-	//friend class ScummDebugger;
+	friend class ScummDebugger;
 	//friend class ScummEngine;
 protected:
 	ScummEngine *_vm;
@@ -125,6 +126,13 @@ public:
 		 */
 		uint32 _roomoffs;
 
+		/**
+		 * The value of the use counter of the resource manager when this
+		 * resource was last used. Among resources with the same counter,
+		 * the least recently used one is expired first.
+		 */
+		uint32 _lastUsed;
+
 	public:
 		Resource();
 		~Resource();
@@ -144,6 +152,9 @@ public:
 		void setOffHeap();
 		void setOnHeap();
 		bool isOffHeap() const;
+
+		void setExpired(bool expired);
+		bool isExpired() const;
 	};
 
 	/**
@@ -170,10 +181,25 @@ public:
 	};
 	ResTypeData _types[rtLast + 1];
 
+	/**
+	 * An entry of the log of expired resources, for debugging.
+	 */
+	struct ExpiredResource {
+		ResType type;
+		ResId idx;
+		uint32 size;
+		byte counter;
+	};
+
 protected:
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
+	uint32 _useCounter;
+
+	// Statistics about expired resources, shown by the debugger
+	uint32 _expiredNum, _expiredSize, _reloadedNum;
+	Common::List<ExpiredResource> _expireLog;
 
 public:
 	ResourceManager(ScummEngine *vm);
@@ -214,6 +240,12 @@ public:
 	 */
 	void setResourceCounter(ResType type, ResId idx, byte counter);
 
+	/**
+	 * Mark the specified resource as used. This resets its counter, and makes
+	 * it the most recently used one of the resources with that counter.
+	 */
+	void touchResource(ResType type, ResId idx);
+
 	/**
 	 * Increment the counter of all unlocked loaded resources.
 	 * The maximal count is 255.
@@ -230,6 +262,9 @@ protected:
 	void expireResources(uint32 size);
 };
 
+/** Returns a printable name of the given resource type, for debug output. */
+const char *nameOfResType(ResType type);
+
 } // End of namespace Scumm
 
 #endif
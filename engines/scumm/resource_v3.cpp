@@ -28,8 +28,6 @@
 
 namespace Scumm {
 
-extern const char *nameOfResType(ResType type);
-
 int ScummEngine_v3old::readResTypeList(ResType type) {
 	uint num;
 	ResId idx;
@@ -28,8 +28,6 @@
 
 namespace Scumm {
 
-extern const char *nameOfResType(ResType type);
-
 int ScummEngine_v4::readResTypeList(ResType type) {
 	uint num;
 
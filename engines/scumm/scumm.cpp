@@ -1309,7 +1309,15 @@ void ScummEngine::setupScumm() {
 		maxHeapThreshold = 550000;
 	}
 
-	_res->setHeapThreshold(400000, maxHeapThreshold);
+	// The heap size can be overridden (in KB), e.g. to stop HE games with
+	// big images from reloading the same resources over and over
+	if (ConfMan.hasKey("resource_heap_size"))
+		maxHeapThreshold = MAX(ConfMan.getInt("resource_heap_size"), 1) * 1024;
+
+	// When the heap is full, resources are expired until a quarter of it is
+	// free again. With a fixed lower threshold, the big heaps would be emptied
+	// almost completely, only to reload most of it right away.
+	_res->setHeapThreshold(maxHeapThreshold / 4 * 3, maxHeapThreshold);
 
 	free(_compositeBuf);
 	_compositeBuf = (byte *)malloc(_screenWidth * _textSurfaceMultiplier * _screenHeight * _textSurfaceMultiplier * _outputPixelFormat.bytesPerPixel);
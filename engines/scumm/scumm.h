@@ -38,6 +38,7 @@
 #include "graphics/surface.h"
 #include "graphics/sjis.h"
 
+#include "scumm/boxes.h"
 #include "scumm/gfx.h"
 #include "scumm/detection.h"
 #include "scumm/script.h"
@@ -1143,9 +1144,13 @@ protected:
 	void setBoxScaleSlot(int box, int slot);
 	void convertScaleTableToScaleSlot(int slot);
 
-	void calcItineraryMatrix(byte *itineraryMatrix, int num);
+	void calcItineraryMatrix(byte *itineraryMatrix, int num, const byte *neighbors = 0);
 	void createBoxMatrix();
 	virtual bool areBoxesNeighbors(int i, int j);
+	bool doBoxesTouch(BoxCoords box, BoxCoords box2) const;
+	void updateBoxMatrixCache(int num);
+
+	BoxMatrixCache _boxMatrixCache;
 
 	/* String class */
 public:
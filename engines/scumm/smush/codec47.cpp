@@ -27,6 +27,12 @@
 #include "scumm/bomp.h"
 #include "scumm/smush/codec47.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace Scumm {
 
 #if defined(SCUMM_NEED_ALIGNMENT)
@@ -70,6 +76,77 @@ namespace Scumm {
 		(dst)[1] = val;	\
 	} while (0)
 
+/* Set each pixel of a line to val1 where mask is 0xFF, and to val2 where it is 0 */
+
+#if defined(SCUMM_NEED_ALIGNMENT)
+
+#define FILL_GLYPH_4X1_LINE(dst, mask, val1, val2)		\
+	do {							\
+		int j;						\
+		for (j = 0; j < 4; j++)				\
+			(dst)[j] = (mask)[j] ? (val1) : (val2);	\
+	} while (0)
+
+#else /* SCUMM_NEED_ALIGNMENT */
+
+#define FILL_GLYPH_4X1_LINE(dst, mask, val1, val2)			\
+	do {								\
+		const uint32 m = *(const uint32 *)(mask);		\
+		*(uint32 *)(dst) = (((uint32)(val1) * 0x01010101U) & m) |	\
+		                   (((uint32)(val2) * 0x01010101U) & ~m);	\
+	} while (0)
+
+#endif /* SCUMM_NEED_ALIGNMENT */
+
+#if defined(__SSE2__)
+
+#define COPY_8X1_LINE(dst, src)			\
+	_mm_storel_epi64((__m128i *)(dst), _mm_loadl_epi64((const __m128i *)(src)))
+
+#define FILL_8X1_LINE(dst, val)			\
+	_mm_storel_epi64((__m128i *)(dst), _mm_set1_epi8((char)(val)))
+
+#define FILL_GLYPH_8X1_LINE(dst, mask, val1, val2)				\
+	do {									\
+		const __m128i m = _mm_loadl_epi64((const __m128i *)(mask));	\
+		_mm_storel_epi64((__m128i *)(dst),				\
+			_mm_or_si128(_mm_and_si128(m, _mm_set1_epi8((char)(val1))),	\
+			             _mm_andnot_si128(m, _mm_set1_epi8((char)(val2)))));	\
+	} while (0)
+
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#define COPY_8X1_LINE(dst, src)			\
+	vst1_u8((dst), vld1_u8(src))
+
+#define FILL_8X1_LINE(dst, val)			\
+	vst1_u8((dst), vdup_n_u8(val))
+
+#define FILL_GLYPH_8X1_LINE(dst, mask, val1, val2)	\
+	vst1_u8((dst), vbsl_u8(vld1_u8(mask), vdup_n_u8(val1), vdup_n_u8(val2)))
+
+#else
+
+#define COPY_8X1_LINE(dst, src)			\
+	do {					\
+		COPY_4X1_LINE(dst, src);	\
+		COPY_4X1_LINE((dst) + 4, (src) + 4);	\
+	} while (0)
+
+#define FILL_8X1_LINE(dst, val)			\
+	do {					\
+		FILL_4X1_LINE(dst, val);	\
+		FILL_4X1_LINE((dst) + 4, val);	\
+	} while (0)
+
+#define FILL_GLYPH_8X1_LINE(dst, mask, val1, val2)			\
+	do {								\
+		FILL_GLYPH_4X1_LINE(dst, mask, val1, val2);		\
+		FILL_GLYPH_4X1_LINE((dst) + 4, (mask) + 4, val1, val2);	\
+	} while (0)
+
+#endif
+
 static const  int8 codec47_table_small1[] = {
   0, 1, 2, 3, 3, 3, 3, 2, 1, 0, 0, 0, 1, 2, 2, 1,
 };
@@ -338,6 +415,25 @@ void Codec47Decoder::makeTables47(int width) {
 	} while (c < 32768);
 }
 
+void Codec47Decoder::makeGlyphMasks() {
+	// The two pixel lists of each glyph together cover the whole block, so
+	// glyphs can be drawn line by line, choosing one of the two colors for
+	// each pixel by a mask
+	for (int glyph = 0; glyph < 256; glyph++) {
+		const byte *big = _tableBig + glyph * 388;
+		byte *mask = _glyphMaskBig + glyph * 64;
+		memset(mask, 0, 64);
+		for (int i = 0; i < big[384]; i++)
+			mask[big[256 + i]] = 0xFF;
+
+		const byte *small = _tableSmall + glyph * 128;
+		mask = _glyphMaskSmall + glyph * 16;
+		memset(mask, 0, 16);
+		for (int i = 0; i < small[96]; i++)
+			mask[small[64 + i]] = 0xFF;
+	}
+}
+
 #ifdef USE_ARM_SMUSH_ASM
 
 #ifndef IPHONE
@@ -413,20 +509,13 @@ void Codec47Decoder::level2(byte *d_dst) {
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
-		byte *tmp_ptr = _tableSmall + *_d_src++ * 128;
-		int32 l = tmp_ptr[96];
-		byte val = *_d_src++;
-		int16 *tmp_ptr2 = (int16 *)tmp_ptr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
-		}
-		l = tmp_ptr[97];
-		val = *_d_src++;
-		tmp_ptr2 = (int16 *)(tmp_ptr + 32);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
+		const byte *mask = _glyphMaskSmall + *_d_src++ * 16;
+		byte val1 = *_d_src++;
+		byte val2 = *_d_src++;
+		for (i = 0; i < 4; i++) {
+			FILL_GLYPH_4X1_LINE(d_dst, mask, val1, val2);
+			mask += 4;
+			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFC) {
 		tmp = _offset2;
@@ -444,15 +533,14 @@ void Codec47Decoder::level2(byte *d_dst) {
 }
 
 void Codec47Decoder::level1(byte *d_dst) {
-	int32 tmp, tmp2;
+	int32 tmp2;
 	byte code = *_d_src++;
 	int i;
 
 	if (code < 0xF8) {
 		tmp2 = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFF) {
@@ -466,39 +554,28 @@ void Codec47Decoder::level1(byte *d_dst) {
 	} else if (code == 0xFE) {
 		byte t = *_d_src++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
-		tmp = *_d_src++;
-		byte *tmp_ptr = _tableBig + tmp * 388;
-		byte l = tmp_ptr[384];
-		byte val = *_d_src++;
-		int16 *tmp_ptr2 = (int16 *)tmp_ptr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
-		}
-		l = tmp_ptr[385];
-		val = *_d_src++;
-		tmp_ptr2 = (int16 *)(tmp_ptr + 128);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
+		const byte *mask = _glyphMaskBig + *_d_src++ * 64;
+		byte val1 = *_d_src++;
+		byte val2 = *_d_src++;
+		for (i = 0; i < 8; i++) {
+			FILL_GLYPH_8X1_LINE(d_dst, mask, val1, val2);
+			mask += 8;
+			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFC) {
 		tmp2 = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else {
 		byte t = _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	}
@@ -532,6 +609,7 @@ Codec47Decoder::Codec47Decoder(int width, int height) {
 	if ((_tableBig != NULL) && (_tableSmall != NULL)) {
 		makeTablesInterpolation(4);
 		makeTablesInterpolation(8);
+		makeGlyphMasks();
 	}
 
 	_frameSize = _width * _height;
@@ -42,11 +42,14 @@ private:
 	byte *_tableBig;
 	byte *_tableSmall;
 	int16 _table[256];
+	byte _glyphMaskBig[256 * 64];
+	byte _glyphMaskSmall[256 * 16];
 	int32 _frameSize;
 	int _width, _height;
 
 	void makeTablesInterpolation(int param);
 	void makeTables47(int width);
+	void makeGlyphMasks();
 	void level1(byte *d_dst);
 	void level2(byte *d_dst);
 	void level3(byte *d_dst);
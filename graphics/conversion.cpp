@@ -22,6 +22,17 @@
 #include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 
+#if defined(__SSE2__)
+#define USE_SSE2_CONVERSION
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define USE_NEON_CONVERSION
+#include <arm_neon.h>
+#endif
+
 namespace Graphics {
 
 // TODO: YUV to RGB conversion function
@@ -146,4 +157,188 @@ bool crossBlit(byte *dst, const byte *src, int dstpitch, int srcpitch,
 	return true;
 }
 
+void keyComposite(byte *dst, int dstPitch, const byte *src, int srcPitch,
+						const byte *layer, int layerPitch, int w, int h, byte key) {
+	const uint32 key32 = key * 0x01010101U;
+#if defined(USE_SSE2_CONVERSION)
+	const __m128i keyVector = _mm_set1_epi8((char)key);
+#elif defined(USE_NEON_CONVERSION)
+	const uint8x16_t keyVector = vdupq_n_u8(key);
+#endif
+
+	for (int y = 0; y < h; y++) {
+		int x = 0;
+
+		// Sixteen pixels at a time where vector instructions are available
+#if defined(USE_SSE2_CONVERSION)
+		for (; x + 16 <= w; x += 16) {
+			const __m128i layerPixels = _mm_loadu_si128((const __m128i *)(layer + x));
+			const __m128i srcPixels = _mm_loadu_si128((const __m128i *)(src + x));
+			const __m128i mask = _mm_cmpeq_epi8(layerPixels, keyVector);
+			_mm_storeu_si128((__m128i *)(dst + x), _mm_or_si128(_mm_and_si128(mask, srcPixels), _mm_andnot_si128(mask, layerPixels)));
+		}
+#elif defined(USE_NEON_CONVERSION)
+		for (; x + 16 <= w; x += 16) {
+			const uint8x16_t layerPixels = vld1q_u8(layer + x);
+			const uint8x16_t srcPixels = vld1q_u8(src + x);
+			const uint8x16_t mask = vceqq_u8(layerPixels, keyVector);
+			vst1q_u8(dst + x, vbslq_u8(mask, srcPixels, layerPixels));
+		}
+#endif
+
+		// Otherwise four pixels at a time, if the rows allow aligned access
+		if (IS_ALIGNED(dst + x, 4) && IS_ALIGNED(src + x, 4) && IS_ALIGNED(layer + x, 4)) {
+			for (; x + 4 <= w; x += 4) {
+				const uint32 temp = *(const uint32 *)(layer + x);
+
+				// Generate a byte mask for those layer pixels (bytes) with
+				// the key color. In the end, each byte in mask will be
+				// either equal to 0x00 or 0xFF.
+				// Doing it this way avoids branches and bytewise operations,
+				// at the cost of readability ;).
+				uint32 mask = temp ^ key32;
+				mask = (((mask & 0x7f7f7f7f) + 0x7f7f7f7f) | mask) & 0x80808080;
+				mask = ((mask >> 7) + 0x7f7f7f7f) ^ 0x80808080;
+
+				// The following line is equivalent to this code:
+				//   dst = (src & mask) | (temp & ~mask);
+				// However, some compilers can generate somewhat better
+				// machine code for this equivalent statement:
+				*(uint32 *)(dst + x) = ((temp ^ *(const uint32 *)(src + x)) & mask) ^ temp;
+			}
+		}
+
+		for (; x < w; x++)
+			dst[x] = (layer[x] == key) ? src[x] : layer[x];
+
+		dst += dstPitch;
+		src += srcPitch;
+		layer += layerPitch;
+	}
+}
+
+#if defined(USE_SSE2_CONVERSION) || defined(USE_NEON_CONVERSION)
+#define USE_VECTOR_LOOKUP
+
+/**
+ * Looks up sixteen pixels at once, for lookupNibbles(). The pixels at even
+ * offsets are looked up in the first table, the ones at odd offsets in the
+ * second one.
+ */
+class NibbleLookup {
+public:
+	NibbleLookup(const byte *even, const byte *odd) {
+#if defined(USE_SSE2_CONVERSION)
+		_lowNibble = _mm_set1_epi8(0x0F);
+#if defined(__SSSE3__)
+		_even = _mm_loadu_si128((const __m128i *)even);
+		_odd = _mm_loadu_si128((const __m128i *)odd);
+		_oddLanes = _mm_set1_epi16((short)0xFF00);
+#else
+		// Without a byte shuffle, every nibble is compared separately
+		for (int i = 0; i < 16; i++) {
+			_nibbles[i] = _mm_set1_epi8(i);
+			_entries[i] = _mm_set1_epi16((short)(even[i] | (odd[i] << 8)));
+		}
+#endif
+#else
+		static const byte oddLanes[8] = { 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF };
+		_lowNibble = vdup_n_u8(0x0F);
+		_even.val[0] = vld1_u8(even);
+		_even.val[1] = vld1_u8(even + 8);
+		_odd.val[0] = vld1_u8(odd);
+		_odd.val[1] = vld1_u8(odd + 8);
+		_oddLanes = vld1_u8(oddLanes);
+#endif
+	}
+
+#if defined(USE_SSE2_CONVERSION)
+	__m128i lookup(const byte *src) const {
+		const __m128i pixels = _mm_and_si128(_mm_loadu_si128((const __m128i *)src), _lowNibble);
+#if defined(__SSSE3__)
+		return _mm_or_si128(_mm_andnot_si128(_oddLanes, _mm_shuffle_epi8(_even, pixels)),
+		                    _mm_and_si128(_oddLanes, _mm_shuffle_epi8(_odd, pixels)));
+#else
+		__m128i result = _mm_setzero_si128();
+		for (int i = 0; i < 16; i++)
+			result = _mm_or_si128(result, _mm_and_si128(_mm_cmpeq_epi8(pixels, _nibbles[i]), _entries[i]));
+		return result;
+#endif
+	}
+#else
+	uint8x16_t lookup(const byte *src) const {
+		const uint8x16_t pixels = vld1q_u8(src);
+		return vcombine_u8(lookup(vget_low_u8(pixels)), lookup(vget_high_u8(pixels)));
+	}
+
+private:
+	uint8x8_t lookup(uint8x8_t pixels) const {
+		pixels = vand_u8(pixels, _lowNibble);
+		return vbsl_u8(_oddLanes, vtbl2_u8(_odd, pixels), vtbl2_u8(_even, pixels));
+	}
+#endif
+
+private:
+#if defined(USE_SSE2_CONVERSION)
+	__m128i _lowNibble;
+#if defined(__SSSE3__)
+	__m128i _even, _odd, _oddLanes;
+#else
+	__m128i _nibbles[16], _entries[16];
+#endif
+#else
+	uint8x8_t _lowNibble, _oddLanes;
+	uint8x8x2_t _even, _odd;
+#endif
+};
+#endif
+
+void lookupNibbles(byte *dst, const byte *src, int w, const byte *evenTable, const byte *oddTable) {
+	int x = 0;
+
+#ifdef USE_VECTOR_LOOKUP
+	const NibbleLookup table(evenTable, oddTable);
+	for (; x + 16 <= w; x += 16) {
+#if defined(USE_SSE2_CONVERSION)
+		_mm_storeu_si128((__m128i *)(dst + x), table.lookup(src + x));
+#else
+		vst1q_u8(dst + x, table.lookup(src + x));
+#endif
+	}
+#endif
+
+	for (; x < w; x++)
+		dst[x] = ((x & 1) ? oddTable : evenTable)[src[x] & 0xF];
+}
+
+void lookupNibblesToBits(byte *dst, const byte *src, int w, const byte *evenTable, const byte *oddTable) {
+	int x = 0;
+
+#ifdef USE_VECTOR_LOOKUP
+	const NibbleLookup table(evenTable, oddTable);
+	for (; x + 16 <= w; x += 16) {
+#if defined(USE_SSE2_CONVERSION)
+		const __m128i values = table.lookup(src + x);
+		const __m128i one = _mm_set1_epi8(1);
+		const __m128i high = _mm_and_si128(_mm_srli_epi16(values, 1), one);
+		const __m128i low = _mm_and_si128(values, one);
+		_mm_storeu_si128((__m128i *)(dst + 2 * x), _mm_unpacklo_epi8(high, low));
+		_mm_storeu_si128((__m128i *)(dst + 2 * x + 16), _mm_unpackhi_epi8(high, low));
+#else
+		const uint8x16_t values = table.lookup(src + x);
+		uint8x16x2_t bits;
+		bits.val[0] = vandq_u8(vshrq_n_u8(values, 1), vdupq_n_u8(1));
+		bits.val[1] = vandq_u8(values, vdupq_n_u8(1));
+		vst2q_u8(dst + 2 * x, bits);
+#endif
+	}
+#endif
+
+	for (; x < w; x++) {
+		const byte value = ((x & 1) ? oddTable : evenTable)[src[x] & 0xF];
+		dst[2 * x] = (value >> 1) & 1;
+		dst[2 * x + 1] = value & 1;
+	}
+}
+
 } // End of namespace Graphics
@@ -69,6 +69,46 @@ inline static void RGB2YUV(byte r, byte g, byte b, byte &y, byte &u, byte &v) {
 bool crossBlit(byte *dst, const byte *src, int dstpitch, int srcpitch,
 						int w, int h, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt);
 
+/**
+ * Composites an 8 bit layer over an 8 bit background. Every pixel of the
+ * layer which is not the key color is written to the destination, the
+ * background pixel below it otherwise.
+ *
+ * @param dst		the buffer which will receive the composited pixels
+ * @param dstPitch	width in bytes of one full line of the dest buffer
+ * @param src		the background
+ * @param srcPitch	width in bytes of one full line of the background
+ * @param layer		the layer drawn over the background
+ * @param layerPitch	width in bytes of one full line of the layer
+ * @param w			the width of the graphics data
+ * @param h			the height of the graphics data
+ * @param key		the transparent color of the layer
+ */
+void keyComposite(byte *dst, int dstPitch, const byte *src, int srcPitch,
+						const byte *layer, int layerPitch, int w, int h, byte key);
+
+/**
+ * Replaces every pixel of a row by an entry of a 16 entry table, indexed by
+ * the low nibble of the pixel. The pixels at even offsets are looked up in
+ * the first table, the ones at odd offsets in the second one. This is how
+ * 16 color graphics are dithered to 4 colors.
+ *
+ * @param dst		the row which will receive the looked up pixels, which
+ *					may be the same as src
+ * @param src		the row of pixels to look up
+ * @param w			the number of pixels
+ * @param evenTable	the table for the pixels at even offsets
+ * @param oddTable	the table for the pixels at odd offsets
+ */
+void lookupNibbles(byte *dst, const byte *src, int w, const byte *evenTable, const byte *oddTable);
+
+/**
+ * Like lookupNibbles(), but for tables holding 2 bit values. The two bits
+ * of every looked up value are written as two bytes, the high bit first,
+ * so dst receives 2 * w bytes.
+ */
+void lookupNibblesToBits(byte *dst, const byte *src, int w, const byte *evenTable, const byte *oddTable);
+
 } // End of namespace Graphics
 
 #endif // GRAPHICS_CONVERSION_H
@@ -21,6 +21,7 @@
  */
 
 #include "graphics/scaler/intern.h"
+#include "common/textconsole.h"
 
 #ifdef USE_NASM
 // Assembly version of HQ3x
@@ -126,7 +127,35 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 	//	 | w7 | w8 | w9 |
 	//	 +----+----+----+
 
+	// The YUV values of the previous, current and next source row, and
+	// the patterns of the current row.
+	HQRowBuffers buffers(width);
+	if (!buffers.isValid()) {
+		warning("HQ3x: Could not allocate row buffers for width %d", width);
+		return;
+	}
+	uint8 *patterns = buffers.patterns();
+	uint32 *yuvPrev = buffers.yuvRow(0);
+	uint32 *yuvCur = buffers.yuvRow(1);
+	uint32 *yuvNext = buffers.yuvRow(2);
+
+	for (int x = -1; x <= width; ++x) {
+		yuvCur[x + 1] = RGBtoYUV[*(p + x - nextlineSrc)];
+		yuvNext[x + 1] = RGBtoYUV[*(p + x)];
+	}
+
 	while (height--) {
+		// Advance the YUV rows and compute the patterns for the whole row
+		uint32 *yuvTmp = yuvPrev;
+		yuvPrev = yuvCur;
+		yuvCur = yuvNext;
+		yuvNext = yuvTmp;
+		for (int x = -1; x <= width; ++x)
+			yuvNext[x + 1] = RGBtoYUV[*(p + x + nextlineSrc)];
+
+		computeHQPatterns(yuvPrev, yuvCur, yuvNext, width, patterns);
+		const uint8 *pattern = patterns;
+
 		w1 = *(p - 1 - nextlineSrc);
 		w4 = *(p - 1);
 		w7 = *(p - 1 + nextlineSrc);
@@ -143,18 +172,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			w6 = *(p);
 			w9 = *(p + nextlineSrc);
 
-			int pattern = 0;
-			const int yuv5 = YUV(5);
-			if (w5 != w1 && diffYUV(yuv5, YUV(1))) pattern |= 0x0001;
-			if (w5 != w2 && diffYUV(yuv5, YUV(2))) pattern |= 0x0002;
-			if (w5 != w3 && diffYUV(yuv5, YUV(3))) pattern |= 0x0004;
-			if (w5 != w4 && diffYUV(yuv5, YUV(4))) pattern |= 0x0008;
-			if (w5 != w6 && diffYUV(yuv5, YUV(6))) pattern |= 0x0010;
-			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
-			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
-			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
-
-			switch (pattern) {
+			switch (*pattern++) {
 			case 0:
 			case 1:
 			case 4:
@@ -0,0 +1,135 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "graphics/scaler/intern.h"
+#include "common/endian.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*
+ * The YUV values are encoded as 0x00YYUUVV. diffYUV considers two values
+ * different, if Y differs by more than 0x30, U by more than 7 or V by more
+ * than 6. The vector code computes the absolute byte differences, subtracts
+ * these thresholds with unsigned saturation and checks whether anything
+ * remains.
+ */
+#define HQ_YUV_THRESHOLDS 0x00300706
+
+#if defined(__SSE2__)
+
+static inline __m128i diffYUV4(__m128i yuv1, __m128i yuv2, int bit) {
+	const __m128i absDiff = _mm_or_si128(_mm_subs_epu8(yuv1, yuv2), _mm_subs_epu8(yuv2, yuv1));
+	const __m128i over = _mm_subs_epu8(absDiff, _mm_set1_epi32(HQ_YUV_THRESHOLDS));
+	const __m128i same = _mm_cmpeq_epi32(over, _mm_setzero_si128());
+	return _mm_andnot_si128(same, _mm_set1_epi32(bit));
+}
+
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+static inline uint32x4_t diffYUV4(uint32x4_t yuv1, uint32x4_t yuv2, uint32 bit) {
+	const uint8x16_t absDiff = vabdq_u8(vreinterpretq_u8_u32(yuv1), vreinterpretq_u8_u32(yuv2));
+	const uint8x16_t over = vqsubq_u8(absDiff, vreinterpretq_u8_u32(vdupq_n_u32(HQ_YUV_THRESHOLDS)));
+	const uint32x4_t same = vceqq_u32(vreinterpretq_u32_u8(over), vdupq_n_u32(0));
+	return vbicq_u32(vdupq_n_u32(bit), same);
+}
+
+#endif
+
+void computeHQPatterns(const uint32 *yuvPrev, const uint32 *yuvCur, const uint32 *yuvNext, int width, uint8 *patterns) {
+	int x = 0;
+
+#if defined(__SSE2__)
+	for (; x + 4 <= width; x += 4) {
+		const __m128i yuv5 = _mm_loadu_si128((const __m128i *)(yuvCur + x + 1));
+
+		__m128i pattern = diffYUV4(yuv5, _mm_loadu_si128((const __m128i *)(yuvPrev + x)), 0x0001);
+		pattern = _mm_or_si128(pattern, diffYUV4(yuv5, _mm_loadu_si128((const __m128i *)(yuvPrev + x + 1)), 0x0002));
+		pattern = _mm_or_si128(pattern, diffYUV4(yuv5, _mm_loadu_si128((const __m128i *)(yuvPrev + x + 2)), 0x0004));
+		pattern = _mm_or_si128(pattern, diffYUV4(yuv5, _mm_loadu_si128((const __m128i *)(yuvCur + x)), 0x0008));
+		pattern = _mm_or_si128(pattern, diffYUV4(yuv5, _mm_loadu_si128((const __m128i *)(yuvCur + x + 2)), 0x0010));
+		pattern = _mm_or_si128(pattern, diffYUV4(yuv5, _mm_loadu_si128((const __m128i *)(yuvNext + x)), 0x0020));
+		pattern = _mm_or_si128(pattern, diffYUV4(yuv5, _mm_loadu_si128((const __m128i *)(yuvNext + x + 1)), 0x0040));
+		pattern = _mm_or_si128(pattern, diffYUV4(yuv5, _mm_loadu_si128((const __m128i *)(yuvNext + x + 2)), 0x0080));
+
+		// Narrow the four 32 bit patterns down to bytes
+		pattern = _mm_packs_epi32(pattern, pattern);
+		pattern = _mm_packus_epi16(pattern, pattern);
+		WRITE_UINT32(patterns + x, _mm_cvtsi128_si32(pattern));
+	}
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+	for (; x + 4 <= width; x += 4) {
+		const uint32x4_t yuv5 = vld1q_u32(yuvCur + x + 1);
+
+		uint32x4_t pattern = diffYUV4(yuv5, vld1q_u32(yuvPrev + x), 0x0001);
+		pattern = vorrq_u32(pattern, diffYUV4(yuv5, vld1q_u32(yuvPrev + x + 1), 0x0002));
+		pattern = vorrq_u32(pattern, diffYUV4(yuv5, vld1q_u32(yuvPrev + x + 2), 0x0004));
+		pattern = vorrq_u32(pattern, diffYUV4(yuv5, vld1q_u32(yuvCur + x), 0x0008));
+		pattern = vorrq_u32(pattern, diffYUV4(yuv5, vld1q_u32(yuvCur + x + 2), 0x0010));
+		pattern = vorrq_u32(pattern, diffYUV4(yuv5, vld1q_u32(yuvNext + x), 0x0020));
+		pattern = vorrq_u32(pattern, diffYUV4(yuv5, vld1q_u32(yuvNext + x + 1), 0x0040));
+		pattern = vorrq_u32(pattern, diffYUV4(yuv5, vld1q_u32(yuvNext + x + 2), 0x0080));
+
+		// Narrow the four 32 bit patterns down to bytes
+		uint8 narrowed[8];
+		vst1_u8(narrowed, vmovn_u16(vcombine_u16(vmovn_u32(pattern), vmovn_u32(pattern))));
+		memcpy(patterns + x, narrowed, 4);
+	}
+#endif
+
+	// Handle the remaining pixels (or all of them without vector unit)
+	for (; x < width; ++x) {
+		const int yuv5 = yuvCur[x + 1];
+		int pattern = 0;
+
+		if (diffYUV(yuv5, yuvPrev[x    ])) pattern |= 0x0001;
+		if (diffYUV(yuv5, yuvPrev[x + 1])) pattern |= 0x0002;
+		if (diffYUV(yuv5, yuvPrev[x + 2])) pattern |= 0x0004;
+		if (diffYUV(yuv5, yuvCur[x     ])) pattern |= 0x0008;
+		if (diffYUV(yuv5, yuvCur[x + 2 ])) pattern |= 0x0010;
+		if (diffYUV(yuv5, yuvNext[x    ])) pattern |= 0x0020;
+		if (diffYUV(yuv5, yuvNext[x + 1])) pattern |= 0x0040;
+		if (diffYUV(yuv5, yuvNext[x + 2])) pattern |= 0x0080;
+
+		patterns[x] = pattern;
+	}
+}
+
+HQRowBuffers::HQRowBuffers(int width) : _width(width) {
+	if (width <= kMaxStackWidth) {
+		_yuv = _stackYUV;
+		_patterns = _stackPatterns;
+	} else {
+		_yuv = (uint32 *)malloc(3 * (width + 2) * sizeof(uint32));
+		_patterns = (uint8 *)malloc(width);
+	}
+}
+
+HQRowBuffers::~HQRowBuffers() {
+	if (_yuv != _stackYUV)
+		free(_yuv);
+	if (_patterns != _stackPatterns)
+		free(_patterns);
+}
@@ -218,4 +218,52 @@ static inline bool diffYUV(int yuv1, int yuv2) {
 */
 }
 
+/**
+ * Compute the neighbourhood patterns used by the hq scaler family for a
+ * row of pixels. Bit n-1 of a pattern is set when the YUV value of the
+ * neighbour wn differs from the one of the center pixel w5 according to
+ * diffYUV (w1..w3 are the upper, w7..w9 the lower neighbours, see hq2x.cpp).
+ *
+ * The three YUV rows must contain width + 2 values each, starting with the
+ * pixel left of the first one. On targets supporting SSE2 or NEON, four
+ * patterns are computed at once.
+ *
+ * Only this part of the hq scalers is vectorized. The interpolation that
+ * follows is a switch over all 256 patterns, so neighbouring pixels take
+ * unrelated code paths with different blend weights and there is nothing
+ * to run in parallel lanes without evaluating every case for every pixel.
+ */
+void computeHQPatterns(const uint32 *yuvPrev, const uint32 *yuvCur, const uint32 *yuvNext, int width, uint8 *patterns);
+
+/**
+ * The rolling rows of YUV values and the patterns of the current row used
+ * by the hq scalers. These live on the stack for rows of up to
+ * kMaxStackWidth pixels, which covers every game screen. Only wider rows
+ * fall back to the heap, in which case isValid() has to be checked.
+ *
+ * The buffers are deliberately not kept around between calls: the SDL
+ * backend can run several scalers at once on its worker threads.
+ */
+class HQRowBuffers {
+public:
+	enum {
+		kMaxStackWidth = 640
+	};
+
+	HQRowBuffers(int width);
+	~HQRowBuffers();
+
+	bool isValid() const { return _yuv != 0 && _patterns != 0; }
+
+	uint32 *yuvRow(int row) { return _yuv + row * (_width + 2); }
+	uint8 *patterns() { return _patterns; }
+
+private:
+	int _width;
+	uint32 *_yuv;
+	uint8 *_patterns;
+	uint32 _stackYUV[3 * (kMaxStackWidth + 2)];
+	uint8 _stackPatterns[kMaxStackWidth];
+};
+
 #endif
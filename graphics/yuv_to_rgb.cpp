@@ -85,9 +85,18 @@
 
 #include "common/scummsys.h"
 #include "common/singleton.h"
+#include "common/util.h"
 
 #include "graphics/surface.h"
 
+#if defined(__SSE2__)
+#define USE_SSE2_YUV
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define USE_NEON_YUV
+#include <arm_neon.h>
+#endif
+
 namespace Graphics {
 
 class YUVToRGBLookup {
@@ -198,6 +207,213 @@ namespace Graphics {
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
 
+/*
+ * Adds the luma of each pixel to its red, green and blue chroma terms, clamps
+ * the channels and packs them into the destination format. With SSE2 or NEON,
+ * this is done for eight pixels at a time.
+ */
+static inline uint32 packYUVPixel(const PixelFormat &format, int r, int g, int b) {
+	return format.RGBToColor(CLIP(r, 0, 255), CLIP(g, 0, 255), CLIP(b, 0, 255));
+}
+
+template<typename PixelInt>
+static void convertYUVRow(byte *dstPtr, const PixelFormat &format, const byte *ySrc, const int16 *rTerms, const int16 *gTerms, const int16 *bTerms, int width) {
+	PixelInt *dst = (PixelInt *)dstPtr;
+	const uint32 alpha = format.RGBToColor(0, 0, 0);
+	int x = 0;
+
+#if defined(USE_SSE2_YUV)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i rLoss = _mm_cvtsi32_si128(format.rLoss), rShift = _mm_cvtsi32_si128(format.rShift);
+	const __m128i gLoss = _mm_cvtsi32_si128(format.gLoss), gShift = _mm_cvtsi32_si128(format.gShift);
+	const __m128i bLoss = _mm_cvtsi32_si128(format.bLoss), bShift = _mm_cvtsi32_si128(format.bShift);
+
+	for (; x + 8 <= width; x += 8) {
+		const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(ySrc + x)), zero);
+
+		// Saturating packing to bytes clamps to 0..255
+		__m128i r = _mm_add_epi16(y, _mm_loadu_si128((const __m128i *)(rTerms + x)));
+		__m128i g = _mm_add_epi16(y, _mm_loadu_si128((const __m128i *)(gTerms + x)));
+		__m128i b = _mm_add_epi16(y, _mm_loadu_si128((const __m128i *)(bTerms + x)));
+		r = _mm_unpacklo_epi8(_mm_packus_epi16(r, r), zero);
+		g = _mm_unpacklo_epi8(_mm_packus_epi16(g, g), zero);
+		b = _mm_unpacklo_epi8(_mm_packus_epi16(b, b), zero);
+
+		if (sizeof(PixelInt) == 2) {
+			__m128i pixels = _mm_set1_epi16((int16)alpha);
+			pixels = _mm_or_si128(pixels, _mm_sll_epi16(_mm_srl_epi16(r, rLoss), rShift));
+			pixels = _mm_or_si128(pixels, _mm_sll_epi16(_mm_srl_epi16(g, gLoss), gShift));
+			pixels = _mm_or_si128(pixels, _mm_sll_epi16(_mm_srl_epi16(b, bLoss), bShift));
+			_mm_storeu_si128((__m128i *)(dst + x), pixels);
+		} else {
+			__m128i lo = _mm_set1_epi32(alpha);
+			__m128i hi = lo;
+			lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_srl_epi32(_mm_unpacklo_epi16(r, zero), rLoss), rShift));
+			hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_srl_epi32(_mm_unpackhi_epi16(r, zero), rLoss), rShift));
+			lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_srl_epi32(_mm_unpacklo_epi16(g, zero), gLoss), gShift));
+			hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_srl_epi32(_mm_unpackhi_epi16(g, zero), gLoss), gShift));
+			lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_srl_epi32(_mm_unpacklo_epi16(b, zero), bLoss), bShift));
+			hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_srl_epi32(_mm_unpackhi_epi16(b, zero), bLoss), bShift));
+			_mm_storeu_si128((__m128i *)(dst + x), lo);
+			_mm_storeu_si128((__m128i *)(dst + x + 4), hi);
+		}
+	}
+#elif defined(USE_NEON_YUV)
+	// NEON shifts right by shifting left by a negative amount
+	const int16x8_t rLoss = vdupq_n_s16(-format.rLoss), rShift = vdupq_n_s16(format.rShift);
+	const int16x8_t gLoss = vdupq_n_s16(-format.gLoss), gShift = vdupq_n_s16(format.gShift);
+	const int16x8_t bLoss = vdupq_n_s16(-format.bLoss), bShift = vdupq_n_s16(format.bShift);
+	const int32x4_t rLoss32 = vdupq_n_s32(-format.rLoss), rShift32 = vdupq_n_s32(format.rShift);
+	const int32x4_t gLoss32 = vdupq_n_s32(-format.gLoss), gShift32 = vdupq_n_s32(format.gShift);
+	const int32x4_t bLoss32 = vdupq_n_s32(-format.bLoss), bShift32 = vdupq_n_s32(format.bShift);
+
+	for (; x + 8 <= width; x += 8) {
+		const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(ySrc + x)));
+
+		// Saturating narrowing to bytes clamps to 0..255
+		const uint16x8_t r = vmovl_u8(vqmovun_s16(vaddq_s16(y, vld1q_s16(rTerms + x))));
+		const uint16x8_t g = vmovl_u8(vqmovun_s16(vaddq_s16(y, vld1q_s16(gTerms + x))));
+		const uint16x8_t b = vmovl_u8(vqmovun_s16(vaddq_s16(y, vld1q_s16(bTerms + x))));
+
+		if (sizeof(PixelInt) == 2) {
+			uint16x8_t pixels = vdupq_n_u16((uint16)alpha);
+			pixels = vorrq_u16(pixels, vshlq_u16(vshlq_u16(r, rLoss), rShift));
+			pixels = vorrq_u16(pixels, vshlq_u16(vshlq_u16(g, gLoss), gShift));
+			pixels = vorrq_u16(pixels, vshlq_u16(vshlq_u16(b, bLoss), bShift));
+			vst1q_u16((uint16 *)(dst + x), pixels);
+		} else {
+			uint32x4_t lo = vdupq_n_u32(alpha);
+			uint32x4_t hi = lo;
+			lo = vorrq_u32(lo, vshlq_u32(vshlq_u32(vmovl_u16(vget_low_u16(r)), rLoss32), rShift32));
+			hi = vorrq_u32(hi, vshlq_u32(vshlq_u32(vmovl_u16(vget_high_u16(r)), rLoss32), rShift32));
+			lo = vorrq_u32(lo, vshlq_u32(vshlq_u32(vmovl_u16(vget_low_u16(g)), gLoss32), gShift32));
+			hi = vorrq_u32(hi, vshlq_u32(vshlq_u32(vmovl_u16(vget_high_u16(g)), gLoss32), gShift32));
+			lo = vorrq_u32(lo, vshlq_u32(vshlq_u32(vmovl_u16(vget_low_u16(b)), bLoss32), bShift32));
+			hi = vorrq_u32(hi, vshlq_u32(vshlq_u32(vmovl_u16(vget_high_u16(b)), bLoss32), bShift32));
+			vst1q_u32((uint32 *)(dst + x), lo);
+			vst1q_u32((uint32 *)(dst + x + 4), hi);
+		}
+	}
+#endif
+
+	for (; x < width; x++)
+		dst[x] = packYUVPixel(format, ySrc[x] + rTerms[x], ySrc[x] + gTerms[x], ySrc[x] + bTerms[x]);
+}
+
+#if defined(USE_SSE2_YUV) || defined(USE_NEON_YUV)
+
+/*
+ * The vector code splits the conversion in two steps. First, the red, green
+ * and blue chroma terms of a row are looked up in the color tables, which is
+ * cheap since there is only one chroma sample for several pixels. Then the
+ * luma is added to the terms, clamped and packed into the destination format
+ * for eight pixels at a time. The result is identical to the lookup path.
+ */
+#define USE_VECTOR_YUV
+
+struct YUVChromaRow {
+	enum {
+		// The terms are computed and used for this many pixels at a time, so
+		// that they fit on the stack. A multiple of eight, the vector width.
+		kMaxWidth = 256
+	};
+
+	// Sets the terms of pixel x from the color tables of a lookup. The color
+	// tables carry the offsets into the rgbToPix table, which are removed here.
+	inline void set(int x, const int16 *colorTab, byte u, byte v) {
+		r[x] = colorTab[v] - 256;
+		g[x] = colorTab[256 + v] + colorTab[512 + u] - (768 + 256);
+		b[x] = colorTab[768 + u] - (2 * 768 + 256);
+	}
+
+	int16 r[kMaxWidth], g[kMaxWidth], b[kMaxWidth];
+};
+
+template<typename PixelInt>
+static void convertYUV444ToRGBVector(byte *dstPtr, int dstPitch, const PixelFormat &format, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	YUVChromaRow chroma;
+
+	for (int h = 0; h < yHeight; h++) {
+		for (int x = 0; x < yWidth; x += YUVChromaRow::kMaxWidth) {
+			const int width = MIN<int>(yWidth - x, YUVChromaRow::kMaxWidth);
+
+			for (int w = 0; w < width; w++)
+				chroma.set(w, lookup->_colorTab, uSrc[x + w], vSrc[x + w]);
+
+			convertYUVRow<PixelInt>(dstPtr + x * sizeof(PixelInt), format, ySrc + x, chroma.r, chroma.g, chroma.b, width);
+		}
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+template<typename PixelInt>
+static void convertYUV420ToRGBVector(byte *dstPtr, int dstPitch, const PixelFormat &format, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	YUVChromaRow chroma;
+
+	// Each chroma row is shared by two rows of pixels
+	for (int h = 0; h < yHeight; h += 2) {
+		for (int x = 0; x < yWidth; x += YUVChromaRow::kMaxWidth) {
+			const int width = MIN<int>(yWidth - x, YUVChromaRow::kMaxWidth);
+			const int halfWidth = width >> 1;
+
+			for (int w = 0; w < halfWidth; w++) {
+				chroma.set(w * 2, lookup->_colorTab, uSrc[(x >> 1) + w], vSrc[(x >> 1) + w]);
+				chroma.r[w * 2 + 1] = chroma.r[w * 2];
+				chroma.g[w * 2 + 1] = chroma.g[w * 2];
+				chroma.b[w * 2 + 1] = chroma.b[w * 2];
+			}
+
+			convertYUVRow<PixelInt>(dstPtr + x * sizeof(PixelInt), format, ySrc + x, chroma.r, chroma.g, chroma.b, width);
+			convertYUVRow<PixelInt>(dstPtr + dstPitch + x * sizeof(PixelInt), format, ySrc + yPitch + x, chroma.r, chroma.g, chroma.b, width);
+		}
+
+		dstPtr += dstPitch << 1;
+		ySrc += yPitch << 1;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+template<typename PixelInt>
+static void convertYUV410ToRGBVector(byte *dstPtr, int dstPitch, const PixelFormat &format, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	YUVChromaRow chroma;
+
+	for (int y = 0; y < yHeight; y++) {
+		// Bilinear interpolation of the chroma values, as in the lookup path
+		int yDiff = y & 3;
+		const byte *uRow = uSrc + (y >> 2) * uvPitch;
+		const byte *vRow = vSrc + (y >> 2) * uvPitch;
+
+		for (int x = 0; x < yWidth; x += YUVChromaRow::kMaxWidth) {
+			const int width = MIN<int>(yWidth - x, YUVChromaRow::kMaxWidth);
+			const int quarterWidth = width >> 2;
+			const byte *uChunk = uRow + (x >> 2);
+			const byte *vChunk = vRow + (x >> 2);
+
+			for (int q = 0; q < quarterWidth; q++) {
+				for (int xDiff = 0; xDiff < 4; xDiff++) {
+					byte u = (uChunk[q] * (4 - xDiff) * (4 - yDiff) + uChunk[q + 1] * xDiff * (4 - yDiff) +
+							uChunk[q + uvPitch] * yDiff * (4 - xDiff) + uChunk[q + uvPitch + 1] * xDiff * yDiff) >> 4;
+					byte v = (vChunk[q] * (4 - xDiff) * (4 - yDiff) + vChunk[q + 1] * xDiff * (4 - yDiff) +
+							vChunk[q + uvPitch] * yDiff * (4 - xDiff) + vChunk[q + uvPitch + 1] * xDiff * yDiff) >> 4;
+					chroma.set(q * 4 + xDiff, lookup->_colorTab, u, v);
+				}
+			}
+
+			convertYUVRow<PixelInt>(dstPtr + x * sizeof(PixelInt), format, ySrc + x, chroma.r, chroma.g, chroma.b, width);
+		}
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+	}
+}
+
+#endif
+
 template<typename PixelInt>
 void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
@@ -238,10 +454,17 @@ void convertYUV444ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uS
 	const YUVToRGBLookup *lookup = YUVToRGBMan.getLookup(dst->format);
 
 	// Use a templated function to avoid an if check on every pixel
+#ifdef USE_VECTOR_YUV
+	if (dst->format.bytesPerPixel == 2)
+		convertYUV444ToRGBVector<uint16>((byte *)dst->pixels, dst->pitch, dst->format, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	else
+		convertYUV444ToRGBVector<uint32>((byte *)dst->pixels, dst->pitch, dst->format, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+#else
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV444ToRGB<uint16>((byte *)dst->pixels, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
 		convertYUV444ToRGB<uint32>((byte *)dst->pixels, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+#endif
 }
 
 template<typename PixelInt>
@@ -294,10 +517,17 @@ void convertYUV420ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uS
 	const YUVToRGBLookup *lookup = YUVToRGBMan.getLookup(dst->format);
 
 	// Use a templated function to avoid an if check on every pixel
+#ifdef USE_VECTOR_YUV
+	if (dst->format.bytesPerPixel == 2)
+		convertYUV420ToRGBVector<uint16>((byte *)dst->pixels, dst->pitch, dst->format, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	else
+		convertYUV420ToRGBVector<uint32>((byte *)dst->pixels, dst->pitch, dst->format, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+#else
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV420ToRGB<uint16>((byte *)dst->pixels, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
 		convertYUV420ToRGB<uint32>((byte *)dst->pixels, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+#endif
 }
 
 #define READ_QUAD(ptr, prefix) \
@@ -379,10 +609,24 @@ void convertYUV410ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uS
 	const YUVToRGBLookup *lookup = YUVToRGBMan.getLookup(dst->format);
 
 	// Use a templated function to avoid an if check on every pixel
+#ifdef USE_VECTOR_YUV
+	if (dst->format.bytesPerPixel == 2)
+		convertYUV410ToRGBVector<uint16>((byte *)dst->pixels, dst->pitch, dst->format, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	else
+		convertYUV410ToRGBVector<uint32>((byte *)dst->pixels, dst->pitch, dst->format, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+#else
 	if (dst->format.bytesPerPixel == 2)
 		convertYUV410ToRGB<uint16>((byte *)dst->pixels, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
 		convertYUV410ToRGB<uint32>((byte *)dst->pixels, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+#endif
+}
+
+void convertYUVTermsToRGB(byte *dst, const PixelFormat &format, const byte *ySrc, const int16 *rTerms, const int16 *gTerms, const int16 *bTerms, int width) {
+	if (format.bytesPerPixel == 2)
+		convertYUVRow<uint16>(dst, format, ySrc, rTerms, gTerms, bTerms, width);
+	else
+		convertYUVRow<uint32>(dst, format, ySrc, rTerms, gTerms, bTerms, width);
 }
 
 } // End of namespace Graphics
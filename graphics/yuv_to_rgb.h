@@ -83,6 +83,23 @@ void convertYUV420ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uS
  */
 void convertYUV410ToRGB(Graphics::Surface *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+/**
+ * Convert a row of pixels, given the luma and the chroma terms of each pixel
+ *
+ * This is meant for codecs with their own chroma interpolation or color
+ * conversion formula. Each channel of a pixel is the luma plus the chroma
+ * term of that channel, clamped to 0..255.
+ *
+ * @param dst    the destination row
+ * @param format the format of the destination (must be 16 or 32 bit)
+ * @param ySrc   the source of the y component
+ * @param rTerms the chroma terms of the red channel
+ * @param gTerms the chroma terms of the green channel
+ * @param bTerms the chroma terms of the blue channel
+ * @param width  the number of pixels to convert
+ */
+void convertYUVTermsToRGB(byte *dst, const PixelFormat &format, const byte *ySrc, const int16 *rTerms, const int16 *gTerms, const int16 *bTerms, int width);
+
 } // End of namespace Graphics
 
 #endif
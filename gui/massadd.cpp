@@ -177,6 +177,13 @@ void MassAddDialog::handleTickle() {
 	uint32 t = g_system->getMillis();
 
 	// Perform a breadth-first scan of the filesystem.
+	//
+	// This is done here, a few directories per tickle, rather than on worker
+	// threads: detectGames() is not reentrant. The PluginManager may load and
+	// unload plugins during it, fallback detectors like SCI's return pointers
+	// to static descriptions, and the detection caches are not locked. Most
+	// of the time is spent listing and hashing files, which the caches in
+	// the advanced detector avoid on later scans.
 	while (!_scanStack.empty() && (g_system->getMillis() - t) < kMaxScanTime) {
 		Common::FSNode dir = _scanStack.pop();
 
@@ -255,6 +262,9 @@ void MassAddDialog::handleTickle() {
 		// Enable the OK button
 		_okButton->setEnabled(true);
 
+		// Store the checksums computed during the scan in one go
+		EngineMan.flushDetectionCache();
+
 		buf = _("Scan complete!");
 		_dirProgressText->setLabel(buf);
 
@@ -0,0 +1,258 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "common/frac.h"
+
+#include "helper.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	// Mix a sine into an output buffer pre-filled with values which make
+	// the result saturate in both directions, and compare the result with
+	// what the reference scalar code computes.
+	void copyMixTestTemplate(const bool isStereo, const bool reverseStereo, const Audio::st_volume_t volL, const Audio::st_volume_t volR) {
+		const int sampleRate = 11025;
+		// Use an odd number of frames, so the non-vectorized tail is exercised
+		const int frames = sampleRate - 3;
+
+		int16 *sine;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(sampleRate, 1, &sine, true, isStereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(sampleRate, sampleRate, isStereo, reverseStereo);
+
+		int16 *buffer = new int16[frames * 2];
+		int16 *expected = new int16[frames * 2];
+		for (int i = 0; i < frames * 2; ++i)
+			buffer[i] = expected[i] = (int16)(i * 4099);
+
+		for (int i = 0; i < frames; ++i) {
+			const int16 out0 = sine[isStereo ? i * 2 : i];
+			const int16 out1 = sine[isStereo ? i * 2 + 1 : i];
+			Audio::clampedAdd(expected[i * 2 + (reverseStereo ? 1 : 0)], (out0 * (int)volL) / Audio::Mixer::kMaxMixerVolume);
+			Audio::clampedAdd(expected[i * 2 + (reverseStereo ? 0 : 1)], (out1 * (int)volR) / Audio::Mixer::kMaxMixerVolume);
+		}
+
+		TS_ASSERT_EQUALS(converter->flow(*s, buffer, frames, volL, volR), frames);
+		TS_ASSERT_EQUALS(memcmp(buffer, expected, sizeof(int16) * frames * 2), 0);
+
+		delete[] sine;
+		delete[] buffer;
+		delete[] expected;
+		delete converter;
+		delete s;
+	}
+
+	/**
+	 * Straightforward per frame implementation of the simple and linear rate
+	 * converters, as they were before their output was mixed in chunks. The
+	 * converters must produce exactly the same output.
+	 */
+	struct ReferenceConverter {
+		const int16 *input;
+		int inputFrames;
+		int inputPos;
+		bool stereo;
+		bool linear;
+
+		long simplePos;
+		long simpleInc;
+
+		frac_t linearPos;
+		frac_t linearInc;
+		int16 last0, last1, cur0, cur1;
+
+		ReferenceConverter(const int16 *in, int frames, bool isStereo, bool isLinear, int inRate, int outRate)
+			: input(in), inputFrames(frames), inputPos(0), stereo(isStereo), linear(isLinear),
+			  simplePos(1), simpleInc(inRate / outRate),
+			  linearPos(FRAC_ONE), linearInc((frac_t)(((Audio::st_rate_t)inRate << FRAC_BITS) / outRate)),
+			  last0(0), last1(0), cur0(0), cur1(0) {
+		}
+
+		void output(int16 *obuf, bool reverseStereo, int16 out0, int16 out1, Audio::st_volume_t volL, Audio::st_volume_t volR) {
+			Audio::clampedAdd(obuf[reverseStereo ? 1 : 0], (out0 * (int)volL) / Audio::Mixer::kMaxMixerVolume);
+			Audio::clampedAdd(obuf[reverseStereo ? 0 : 1], (out1 * (int)volR) / Audio::Mixer::kMaxMixerVolume);
+		}
+
+		int flow(int16 *obuf, int frames, bool reverseStereo, Audio::st_volume_t volL, Audio::st_volume_t volR) {
+			int done = 0;
+
+			while (done < frames) {
+				if (!linear) {
+					int frame;
+					do {
+						if (inputPos >= inputFrames)
+							return done;
+						frame = inputPos++;
+						simplePos--;
+					} while (simplePos >= 0);
+
+					const int16 out0 = input[stereo ? frame * 2 : frame];
+					const int16 out1 = input[stereo ? frame * 2 + 1 : frame];
+					simplePos += simpleInc;
+
+					output(obuf + done * 2, reverseStereo, out0, out1, volL, volR);
+					done++;
+				} else {
+					while ((frac_t)FRAC_ONE <= linearPos) {
+						if (inputPos >= inputFrames)
+							return done;
+						last0 = cur0;
+						last1 = cur1;
+						cur0 = input[stereo ? inputPos * 2 : inputPos];
+						cur1 = input[stereo ? inputPos * 2 + 1 : inputPos];
+						inputPos++;
+						linearPos -= FRAC_ONE;
+					}
+
+					while (linearPos < (frac_t)FRAC_ONE && done < frames) {
+						const int16 out0 = (int16)(last0 + (((cur0 - last0) * linearPos + FRAC_HALF) >> FRAC_BITS));
+						const int16 out1 = stereo ? (int16)(last1 + (((cur1 - last1) * linearPos + FRAC_HALF) >> FRAC_BITS)) : out0;
+
+						output(obuf + done * 2, reverseStereo, out0, out1, volL, volR);
+						done++;
+						linearPos += linearInc;
+					}
+				}
+			}
+
+			return done;
+		}
+	};
+
+	// Resample a sine with the simple (for integer ratios) or the linear
+	// converter, in calls of varying size which don't line up with the
+	// internal buffers, until the input runs out. Compare the result with
+	// the reference implementation.
+	void resampleMixTestTemplate(const int inRate, const int outRate, const bool isStereo, const bool reverseStereo, const Audio::st_volume_t volL, const Audio::st_volume_t volR) {
+		const int inFrames = inRate;
+		const int outFrames = (int)(((int64)inFrames * outRate) / inRate) + 16;
+		const bool isLinear = (inRate % outRate) != 0;
+
+		int16 *sine;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(inRate, 1, &sine, true, isStereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, isStereo, reverseStereo);
+		ReferenceConverter reference(sine, inFrames, isStereo, isLinear, inRate, outRate);
+
+		int16 *buffer = new int16[outFrames * 2];
+		int16 *expected = new int16[outFrames * 2];
+		for (int i = 0; i < outFrames * 2; ++i)
+			buffer[i] = expected[i] = (int16)(i * 4099);
+
+		static const int chunkSizes[] = { 1, 700, 255, 3, 1024, 257 };
+		int pos = 0;
+		for (int i = 0; pos < outFrames; i = (i + 1) % ARRAYSIZE(chunkSizes)) {
+			const int chunk = MIN(chunkSizes[i], outFrames - pos);
+			const int expectedCount = reference.flow(expected + pos * 2, chunk, reverseStereo, volL, volR);
+
+			TS_ASSERT_EQUALS(converter->flow(*s, buffer + pos * 2, chunk, volL, volR), expectedCount);
+			pos += expectedCount;
+
+			if (expectedCount < chunk)
+				break;
+		}
+
+		// The whole input has to be used up
+		TS_ASSERT_LESS_THAN(pos, outFrames);
+		TS_ASSERT_EQUALS(memcmp(buffer, expected, sizeof(int16) * outFrames * 2), 0);
+
+		delete[] sine;
+		delete[] buffer;
+		delete[] expected;
+		delete converter;
+		delete s;
+	}
+
+	// A constant input signal must result in the same constant output, once
+	// the filter delay has passed.
+	void sincConstantTestTemplate(const int inRate, const int outRate, const Audio::RateConverterQuality quality) {
+		const int inFrames = 4096;
+		const int outFrames = 1024;
+		const int16 value = 12345;
+
+		int16 *input = (int16 *)malloc(sizeof(int16) * inFrames);
+		for (int i = 0; i < inFrames; ++i)
+			input[i] = value;
+
+		Common::SeekableReadStream *data = new Common::MemoryReadStream((const byte *)input, sizeof(int16) * inFrames, DisposeAfterUse::YES);
+		Audio::SeekableAudioStream *s = Audio::makeRawStream(data, inRate, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                                     | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                                     );
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, false, false, quality);
+
+		int16 *buffer = new int16[outFrames * 2];
+		memset(buffer, 0, sizeof(int16) * outFrames * 2);
+		TS_ASSERT_EQUALS(converter->flow(*s, buffer, outFrames, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), outFrames);
+
+		// Skip the frames influenced by the initial silence of the filter
+		const int delay = (32 * outRate) / inRate + 1;
+		for (int i = delay * 2; i < outFrames * 2; ++i) {
+			TS_ASSERT_LESS_THAN_EQUALS(buffer[i], value + 1);
+			TS_ASSERT_LESS_THAN_EQUALS(value - 1, buffer[i]);
+		}
+
+		delete[] buffer;
+		delete converter;
+		delete s;
+	}
+
+public:
+	void test_sinc_fast_upsample() {
+		sincConstantTestTemplate(11025, 48000, Audio::kRateConverterQualitySincFast);
+	}
+
+	void test_sinc_best_upsample() {
+		sincConstantTestTemplate(22050, 44100, Audio::kRateConverterQualitySincBest);
+	}
+
+	void test_sinc_best_downsample() {
+		sincConstantTestTemplate(44100, 22050, Audio::kRateConverterQualitySincBest);
+	}
+
+	void test_copy_mix_mono() {
+		copyMixTestTemplate(false, false, Audio::Mixer::kMaxMixerVolume, 77);
+	}
+
+	void test_copy_mix_stereo() {
+		copyMixTestTemplate(true, false, 129, Audio::Mixer::kMaxMixerVolume);
+	}
+
+	void test_copy_mix_stereo_reversed() {
+		copyMixTestTemplate(true, true, 3, 200);
+	}
+
+	void test_copy_mix_muted() {
+		copyMixTestTemplate(true, false, 0, 0);
+	}
+
+	void test_simple_mix_mono() {
+		resampleMixTestTemplate(22050, 11025, false, false, Audio::Mixer::kMaxMixerVolume, 77);
+	}
+
+	void test_simple_mix_stereo_odd_ratio() {
+		resampleMixTestTemplate(33075, 11025, true, false, 129, Audio::Mixer::kMaxMixerVolume);
+	}
+
+	void test_simple_mix_stereo_reversed() {
+		resampleMixTestTemplate(44100, 11025, true, true, 3, 200);
+	}
+
+	void test_linear_mix_mono_upsample() {
+		resampleMixTestTemplate(11025, 48000, false, false, Audio::Mixer::kMaxMixerVolume, 77);
+	}
+
+	void test_linear_mix_stereo_upsample() {
+		resampleMixTestTemplate(8000, 22050, true, false, 129, Audio::Mixer::kMaxMixerVolume);
+	}
+
+	void test_linear_mix_stereo_downsample() {
+		resampleMixTestTemplate(48000, 44100, true, true, 3, 200);
+	}
+
+	void test_linear_mix_stereo_odd_rates() {
+		resampleMixTestTemplate(11111, 7919, true, false, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+	}
+};
@@ -0,0 +1,152 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/md5.h"
+#include "common/memstream.h"
+
+#include "scumm/smush/codec47.h"
+
+/**
+ * Builds a stream of kFrameCount 128x96 codec47 frames. The first one is
+ * stored raw, the others are made of random blocks using all the block
+ * codes. Motion vectors are only chosen where they stay inside the frame.
+ */
+class Codec47TestVideo {
+public:
+	enum {
+		kWidth = 128,
+		kHeight = 96,
+		kFrameCount = 12,
+		kHeaderSize = 26
+	};
+
+	Codec47TestVideo() : _seed(1) {}
+
+	Common::MemoryWriteStreamDynamic *createFrame(int frameNum) {
+		Common::MemoryWriteStreamDynamic *frame = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+
+		frame->writeUint16LE(frameNum);	// Sequence number
+		frame->writeByte(frameNum == 0 ? 0 : 2);	// Raw or blocks
+		frame->writeByte(nextByte() % 3);	// How the delta buffers are swapped
+		frame->writeUint32LE(0);
+		for (int i = 0; i < 8; i++)
+			frame->writeByte(nextByte());	// Colors of the codes 0xF8 to 0xFF
+		while (frame->size() < kHeaderSize)
+			frame->writeByte(0);
+
+		if (frameNum == 0) {
+			for (int i = 0; i < kWidth * kHeight; i++)
+				frame->writeByte(nextByte());
+		} else {
+			for (int y = 0; y < kHeight; y += 8)
+				for (int x = 0; x < kWidth; x += 8)
+					writeBlock(*frame, x, y, 8);
+		}
+
+		return frame;
+	}
+
+private:
+	struct MotionVector {
+		byte code;
+		int x, y;
+	};
+
+	uint32 _seed;
+
+	byte nextByte() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	void writeBlock(Common::WriteStream &out, int x, int y, int size) {
+		// A few entries of the codec's motion vector table
+		static const MotionVector motionVectors[] = {
+			{ 0x00,   0,   0 }, { 0x01,  -1, -43 }, { 0x3C,  42,  -9 },
+			{ 0x45, -43,  -6 }, { 0x74,  -1,  -1 }, { 0x7F,   2,   0 },
+			{ 0x89,   1,   1 }, { 0xB7,  43,   6 }, { 0xF7,  16,  40 }
+		};
+
+		switch (nextByte() % 8) {
+		case 0:
+		case 1:
+			out.writeByte(0xFF);
+			if (size == 2) {
+				// Raw pixels
+				for (int i = 0; i < 4; i++)
+					out.writeByte(nextByte());
+			} else {
+				const int half = size / 2;
+				writeBlock(out, x, y, half);
+				writeBlock(out, x + half, y, half);
+				writeBlock(out, x, y + half, half);
+				writeBlock(out, x + half, y + half, half);
+			}
+			break;
+		case 2:
+			// A glyph of two colors, or a color of the header for 2x2 blocks
+			out.writeByte(0xFD);
+			if (size != 2) {
+				out.writeByte(nextByte());
+				out.writeByte(nextByte());
+				out.writeByte(nextByte());
+			}
+			break;
+		case 3:
+			out.writeByte(0xFE);
+			out.writeByte(nextByte());
+			break;
+		case 4:
+			// Copy from the other delta buffer
+			out.writeByte(0xFC);
+			break;
+		case 5:
+			out.writeByte(0xF8 + nextByte() % 4);
+			break;
+		default: {
+			const MotionVector &motion = motionVectors[nextByte() % ARRAYSIZE(motionVectors)];
+			if (x + motion.x >= 0 && x + motion.x + size <= kWidth && y + motion.y >= 0 && y + motion.y + size <= kHeight)
+				out.writeByte(motion.code);
+			else
+				out.writeByte(0x00);
+		}
+		}
+	}
+};
+
+class Codec47DecoderTestSuite : public CxxTest::TestSuite
+{
+public:
+	void test_decode() {
+		// The frames as decoded before the lines were drawn with vector
+		// instructions
+		static const char *const frameMD5[Codec47TestVideo::kFrameCount] = {
+			"45632f0377117ff89e3345a2da868f69",
+			"d6c192db45034c19edfa011812169d09",
+			"4d23b8c888c1fd52bafa76133a30f13e",
+			"c331b34b6025aef170fba3a9c8db3c0f",
+			"cb58cef48d511f21feddb4e1cf4906c5",
+			"ab1b6402f40318eb8cbd6849a0984931",
+			"c7b553e7ef94828f6a028207bd22400d",
+			"7996c9a98f6e0fe8f1f8fdca189c47c7",
+			"1692d7708fe500e2f3df7af9a7659c80",
+			"48251f9710845e1c04c79fbabee009e6",
+			"c635d38d72c8491ad5853e9b1932ab0a",
+			"2d7ff36598e27c932f95e173032f6b0a"
+		};
+
+		Codec47TestVideo video;
+		Scumm::Codec47Decoder decoder(Codec47TestVideo::kWidth, Codec47TestVideo::kHeight);
+		byte *dst = new byte[Codec47TestVideo::kWidth * Codec47TestVideo::kHeight];
+
+		for (int i = 0; i < Codec47TestVideo::kFrameCount; i++) {
+			Common::MemoryWriteStreamDynamic *frame = video.createFrame(i);
+			TS_ASSERT(decoder.decode(dst, frame->getData()));
+			delete frame;
+
+			Common::MemoryReadStream stream(dst, Codec47TestVideo::kWidth * Codec47TestVideo::kHeight);
+			TS_ASSERT_EQUALS(Common::computeStreamMD5AsString(stream), frameMD5[i]);
+		}
+
+		delete[] dst;
+	}
+};
@@ -0,0 +1,113 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+
+class ConversionTestSuite : public CxxTest::TestSuite
+{
+private:
+	static byte nextByte(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 16;
+	}
+
+	// Fill a buffer with random values, a quarter of which are the key
+	static void fillBuffer(uint32 &seed, byte *buffer, int size, byte key) {
+		for (int i = 0; i < size; ++i) {
+			const byte value = nextByte(seed);
+			buffer[i] = (value < 64) ? key : value;
+		}
+	}
+
+	// Composite at the given offsets into the buffers, so that the rows are
+	// aligned differently
+	static void checkComposite(uint32 &seed, int offset, int layerOffset, int width) {
+		const int height = 5, dstPitch = 72, srcPitch = 76, layerPitch = 81;
+		const byte key = 0xFD;
+		byte dst[dstPitch * height + 4], src[srcPitch * height + 4], layer[layerPitch * height + 4];
+
+		fillBuffer(seed, dst, sizeof(dst), key);
+		fillBuffer(seed, src, sizeof(src), key);
+		fillBuffer(seed, layer, sizeof(layer), key);
+
+		byte expected[sizeof(dst)];
+		memcpy(expected, dst, sizeof(dst));
+		for (int y = 0; y < height; ++y) {
+			for (int x = 0; x < width; ++x) {
+				const byte pixel = layer[layerOffset + y * layerPitch + x];
+				expected[offset + y * dstPitch + x] = (pixel == key) ? src[offset + y * srcPitch + x] : pixel;
+			}
+		}
+
+		Graphics::keyComposite(dst + offset, dstPitch, src + offset, srcPitch, layer + layerOffset, layerPitch, width, height, key);
+
+		// Also checks that nothing outside of the rectangle was written
+		for (uint i = 0; i < sizeof(dst); ++i)
+			TS_ASSERT_EQUALS(dst[i], expected[i]);
+	}
+
+	static void fillTables(uint32 &seed, byte *even, byte *odd, byte mask) {
+		for (int i = 0; i < 16; ++i) {
+			even[i] = nextByte(seed) & mask;
+			odd[i] = nextByte(seed) & mask;
+		}
+	}
+
+public:
+	void test_key_composite() {
+		uint32 seed = 1;
+
+		// Widths around the vector size and with a remainder, and buffers
+		// which do and do not allow aligned access
+		for (int width = 1; width <= 64; width += 7) {
+			checkComposite(seed, 0, 0, width);
+			checkComposite(seed, 0, 4, width);
+			checkComposite(seed, 1, 3, width);
+			checkComposite(seed, 3, 0, width);
+		}
+		checkComposite(seed, 0, 0, 64);
+		checkComposite(seed, 4, 4, 32);
+	}
+
+	void test_lookup_nibbles() {
+		const int size = 67;
+		byte src[size], dst[size + 1], even[16], odd[16];
+		uint32 seed = 2;
+
+		for (int width = 0; width <= size; width += 3) {
+			for (int i = 0; i < size; ++i)
+				src[i] = nextByte(seed);
+			memset(dst, 0xAA, sizeof(dst));
+			fillTables(seed, even, odd, 0xFF);
+
+			Graphics::lookupNibbles(dst, src, width, even, odd);
+			for (int x = 0; x < width; ++x)
+				TS_ASSERT_EQUALS(dst[x], ((x & 1) ? odd : even)[src[x] & 0xF]);
+			TS_ASSERT_EQUALS(dst[width], 0xAA);
+
+			// In place, as done for dithering
+			Graphics::lookupNibbles(src, src, width, even, odd);
+			TS_ASSERT_SAME_DATA(src, dst, width);
+		}
+	}
+
+	void test_lookup_nibbles_to_bits() {
+		const int size = 67;
+		byte src[size], dst[2 * size + 1], even[16], odd[16];
+		uint32 seed = 3;
+
+		for (int width = 0; width <= size; width += 3) {
+			for (int i = 0; i < size; ++i)
+				src[i] = nextByte(seed);
+			memset(dst, 0xAA, sizeof(dst));
+			fillTables(seed, even, odd, 3);
+
+			Graphics::lookupNibblesToBits(dst, src, width, even, odd);
+			for (int x = 0; x < width; ++x) {
+				const byte value = ((x & 1) ? odd : even)[src[x] & 0xF];
+				TS_ASSERT_EQUALS(dst[2 * x], value >> 1);
+				TS_ASSERT_EQUALS(dst[2 * x + 1], value & 1);
+			}
+			TS_ASSERT_EQUALS(dst[2 * width], 0xAA);
+		}
+	}
+};
@@ -0,0 +1,263 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/util.h"
+#include "graphics/scaler.h"
+#include "graphics/scaler/intern.h"
+
+class HQPatternTestSuite : public CxxTest::TestSuite
+{
+private:
+	// Reference implementation, as used by the original hq scalers
+	static uint8 referencePattern(const uint32 *yuvPrev, const uint32 *yuvCur, const uint32 *yuvNext, int x) {
+		const int yuv5 = yuvCur[x + 1];
+		uint8 pattern = 0;
+
+		if (yuv5 != (int)yuvPrev[x    ] && diffYUV(yuv5, yuvPrev[x    ])) pattern |= 0x0001;
+		if (yuv5 != (int)yuvPrev[x + 1] && diffYUV(yuv5, yuvPrev[x + 1])) pattern |= 0x0002;
+		if (yuv5 != (int)yuvPrev[x + 2] && diffYUV(yuv5, yuvPrev[x + 2])) pattern |= 0x0004;
+		if (yuv5 != (int)yuvCur[x     ] && diffYUV(yuv5, yuvCur[x     ])) pattern |= 0x0008;
+		if (yuv5 != (int)yuvCur[x + 2 ] && diffYUV(yuv5, yuvCur[x + 2 ])) pattern |= 0x0010;
+		if (yuv5 != (int)yuvNext[x    ] && diffYUV(yuv5, yuvNext[x    ])) pattern |= 0x0020;
+		if (yuv5 != (int)yuvNext[x + 1] && diffYUV(yuv5, yuvNext[x + 1])) pattern |= 0x0040;
+		if (yuv5 != (int)yuvNext[x + 2] && diffYUV(yuv5, yuvNext[x + 2])) pattern |= 0x0080;
+
+		return pattern;
+	}
+
+	// Create a YUV value close to base, so that all kinds of differences
+	// around the thresholds show up.
+	static uint32 randomYUV(uint32 &seed, uint32 base) {
+		seed = seed * 1103515245 + 12345;
+		const int y = CLIP<int>(((base >> 16) & 0xFF) + (int)((seed >> 8) % 121) - 60, 0, 255);
+		const int u = CLIP<int>(((base >> 8) & 0xFF) + (int)((seed >> 16) % 19) - 9, 0, 255);
+		const int v = CLIP<int>((base & 0xFF) + (int)((seed >> 24) % 17) - 8, 0, 255);
+		return (y << 16) | (u << 8) | v;
+	}
+
+	enum {
+		kImageWidth = 15,
+		kImageHeight = 9
+	};
+
+	// Fill an RGB565 image, including a one pixel border around it, with
+	// colors which are either equal, similar or very different
+	static void fillImage(uint16 *image) {
+		static const uint16 colors[8] = { 0x0000, 0xFFFF, 0x8410, 0x8430, 0xF800, 0xF820, 0x07E0, 0x001F };
+		uint32 seed = 1;
+		for (int i = 0; i < (kImageWidth + 2) * (kImageHeight + 2); ++i) {
+			seed = seed * 1103515245 + 12345;
+			image[i] = colors[(seed >> 16) & 7];
+		}
+	}
+
+	// Scale the image and compare the result with the output of the
+	// scaler before the pattern computation was vectorized. The reference
+	// images were produced by running fillImage() through HQ2x and HQ3x of
+	// the unmodified scalers (built with USE_HQ_SCALERS and without NASM),
+	// with InitScalers(565), and dumping the scaled pixels.
+	static void checkScaler(ScalerProc *scaler, int factor, const uint16 *reference) {
+		uint16 image[(kImageWidth + 2) * (kImageHeight + 2)];
+		uint16 scaled[kImageWidth * 3 * kImageHeight * 3];
+		fillImage(image);
+
+		InitScalers(565);
+		scaler((const uint8 *)(image + kImageWidth + 3), (kImageWidth + 2) * 2,
+		       (uint8 *)scaled, kImageWidth * factor * 2, kImageWidth, kImageHeight);
+		DestroyScalers();
+
+		for (int i = 0; i < kImageWidth * factor * kImageHeight * factor; ++i)
+			TS_ASSERT_EQUALS(scaled[i], reference[i]);
+	}
+
+public:
+	void test_patterns() {
+#ifdef USE_HQ_SCALERS
+		// Use a width which is not a multiple of the vector size
+		const int width = 331;
+		uint32 rows[3][width + 2];
+		uint8 patterns[width];
+		uint32 seed = 1;
+
+		for (int pass = 0; pass < 64; ++pass) {
+			const uint32 base = 0x00608080 + pass * 0x00010101;
+			for (int r = 0; r < 3; ++r)
+				for (int x = 0; x < width + 2; ++x)
+					rows[r][x] = randomYUV(seed, base);
+
+			computeHQPatterns(rows[0], rows[1], rows[2], width, patterns);
+
+			for (int x = 0; x < width; ++x)
+				TS_ASSERT_EQUALS(patterns[x], referencePattern(rows[0], rows[1], rows[2], x));
+		}
+#endif
+	}
+
+	void test_hq2x() {
+#ifdef USE_HQ_SCALERS
+		static const uint16 hq2xReference[kImageWidth * 2 * kImageHeight * 2] = {
+			0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x07E0, 0x1762, 0x8410, 0x8410, 0x109D, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x07E0,
+			0x07E0, 0x00FB, 0x001F, 0xFFFF, 0xFFFF, 0x8410, 0x8410, 0x0000, 0x1800, 0xF800, 0xF800, 0xFFFF, 0xFFFF, 0x8410, 0x8410,
+			0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x8410, 0x8410, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x07E0,
+			0x07E0, 0x001F, 0x001F, 0xDEFF, 0xFFFF, 0x8410, 0x8410, 0x0000, 0x1800, 0xF800, 0xF800, 0xFFFF, 0xEF7D, 0x8410, 0x8410,
+			0x8430, 0x8410, 0x8410, 0x8410, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800,
+			0xF820, 0x001F, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0xF820, 0xF800, 0x8B8E, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410,
+			0x8430, 0x8410, 0x8410, 0x8410, 0xE882, 0xF820, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800,
+			0xF820, 0x001F, 0x001F, 0x001F, 0x001F, 0x03EF, 0x07E0, 0xD900, 0xF820, 0x8430, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410,
+			0xF800, 0xE882, 0x8410, 0x8410, 0x8410, 0x8410, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF,
+			0xFFFF, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x03EF, 0x07E0, 0x07E0, 0x07E0, 0x1762, 0x8410, 0x8410, 0x1082, 0x0000,
+			0xF800, 0xBA08, 0x8410, 0x8410, 0x8410, 0x8410, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x00FB, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF,
+			0xFFFF, 0x18FF, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x05E7, 0x07E0, 0x07E0, 0x07E0, 0x8430, 0x8430, 0x0000, 0x0000,
+			0xBA08, 0x8410, 0x1762, 0x07E0, 0x07E0, 0x07E0, 0x8410, 0x8410, 0xF800, 0x7BE0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0xF800,
+			0xF8E3, 0xFFFF, 0xFFFF, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x001F, 0x03EF, 0x07E0, 0x07E0, 0xFFFF, 0xFFFF, 0x0000, 0x0000,
+			0x8410, 0x8410, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x8410, 0x8B8E, 0xF800, 0xF800, 0xBA00, 0x3DE0, 0x07E0, 0x07E0, 0xF800,
+			0xF800, 0xFFFF, 0xFFFF, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x07E0, 0x07E0, 0xFFFF, 0xFFFF, 0x0000, 0x0000,
+			0x109D, 0x001F, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0xF820, 0xF800, 0x1800, 0x1800, 0xF800, 0xF820, 0xFFFF, 0xFFFF, 0xF800,
+			0xF800, 0x8430, 0x8430, 0xF820, 0xF820, 0x8410, 0x8410, 0x8410, 0x8430, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0x8410, 0x8410,
+			0x001F, 0x001F, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0xF820, 0xF820, 0x1800, 0x1800, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0xF800,
+			0xE882, 0x8430, 0x8430, 0xF820, 0xF820, 0x8410, 0x8410, 0x8410, 0x8430, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0x8410, 0x8410,
+			0xF820, 0xF820, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x8410, 0x8B8E, 0xF820, 0xF820, 0x8B8E, 0x8410, 0x07E0, 0x07E0, 0x8430,
+			0x8430, 0x1082, 0x0000, 0xFFFF, 0xFFFF, 0x8410, 0x8410, 0xEF7D, 0xFFFF, 0x07E0, 0x07E0, 0xF800, 0xF800, 0x8410, 0x8410,
+			0xF800, 0xF800, 0x07E0, 0x07E0, 0x00FB, 0x001F, 0x8410, 0x8B8E, 0xF820, 0xF820, 0x8410, 0x746E, 0x07E0, 0x07E0, 0x8430,
+			0x8430, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0x8410, 0x8410, 0xFFFF, 0xDFFB, 0x07E0, 0x07E0, 0xF800, 0xF800, 0x8B8E, 0x8410,
+			0xF800, 0xF800, 0x8410, 0x746E, 0x07E0, 0x07E0, 0xF820, 0xF820, 0xFC0F, 0xFFFF, 0x07E0, 0x07E0, 0x00FB, 0x001F, 0x001F,
+			0x001F, 0x07E0, 0x07E0, 0xFFFF, 0xFFFF, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x746E, 0x8410, 0x0000, 0x1800, 0xF800, 0xF800,
+			0xF800, 0xF800, 0x8410, 0x8410, 0x07E0, 0x1EE0, 0xF800, 0xFC0F, 0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F,
+			0x001F, 0x07E0, 0x07E0, 0xFFFF, 0xFFFF, 0xF903, 0xF820, 0x07E0, 0x07E0, 0x8410, 0x8410, 0x1082, 0x0000, 0xF800, 0xF800,
+			0xF800, 0xF800, 0x001F, 0x001F, 0xF800, 0xF800, 0xFBEF, 0xFFFF, 0x8C91, 0x8430, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0x07E0,
+			0x07E0, 0x001F, 0x001F, 0x0000, 0x18E3, 0xFFFF, 0xFFFF, 0x001F, 0x001F, 0xFFFF, 0xEF7D, 0x8410, 0x8430, 0x001F, 0x001F,
+			0xF800, 0xF800, 0x001F, 0x001F, 0xF800, 0xF800, 0xFEFB, 0xFFFF, 0x8430, 0x8BAE, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0x07E0,
+			0x07E0, 0x001F, 0x001F, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0x8430, 0x8430, 0x001F, 0x001F,
+			0xFEFB, 0xFFFF, 0x0000, 0x0000, 0xF800, 0xF800, 0xF800, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0x8430, 0x8430, 0x8430,
+			0x8430, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x0000, 0x0000,
+			0xFFFF, 0xFFFF, 0x18E3, 0x0000, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF800, 0x8B8E, 0x8430, 0x8430,
+			0x8430, 0xE8A2, 0xF820, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x0000, 0x0000,
+		};
+
+		checkScaler(HQ2x, 2, hq2xReference);
+#endif
+	}
+
+	void test_hq3x() {
+#ifdef USE_HQ_SCALERS
+		static const uint16 hq3xReference[kImageWidth * 3 * kImageHeight * 3] = {
+			0xFFFF, 0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x45E8, 0x8410, 0x8410, 0x8410, 0x4217, 0x001F, 0x001F,
+			0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0x03EF, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF,
+			0x8410, 0x8410, 0x8410, 0x0000, 0x0000, 0x7800, 0xF800, 0xF800, 0xF800, 0xFFFF, 0xFFFF, 0xFFFF, 0x8410, 0x8410, 0x8410,
+			0xFFFF, 0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x8410, 0x8410, 0x8410, 0x001F, 0x001F, 0x001F,
+			0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF,
+			0x8410, 0x8410, 0x8410, 0x0000, 0x0000, 0x0000, 0xF800, 0xF800, 0xF800, 0xFFFF, 0xFFFF, 0xFFFF, 0x8410, 0x8410, 0x8410,
+			0xFFFF, 0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x8410, 0x8410, 0x8410, 0x001F, 0x001F, 0x001F,
+			0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x7BFF, 0xFFFF, 0xFFFF,
+			0x8410, 0x8410, 0x8410, 0x0000, 0x0000, 0x7800, 0xF800, 0xF800, 0xF800, 0xFFFF, 0xFFFF, 0xBDF7, 0x8410, 0x8410, 0x8410,
+			0x8430, 0x8430, 0x8410, 0x8410, 0x8410, 0x8410, 0xF820, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000,
+			0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF820, 0xF820, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F,
+			0x07E0, 0x07E0, 0x07E0, 0xF820, 0xF820, 0xF800, 0xBA08, 0x8430, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410,
+			0x8430, 0x8430, 0x8410, 0x8410, 0x8410, 0x8410, 0xF820, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000,
+			0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF820, 0xF820, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F,
+			0x07E0, 0x07E0, 0x07E0, 0xD900, 0xF820, 0xF820, 0x8430, 0x8430, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410,
+			0x8430, 0x8430, 0x8430, 0x8410, 0x8410, 0x8410, 0xBA08, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000,
+			0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF800, 0xF820, 0xF820, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F,
+			0x00FB, 0x06E3, 0x07E0, 0x7C00, 0xD900, 0xF820, 0x8430, 0x8430, 0x8430, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410,
+			0xF800, 0xE882, 0xBA08, 0x8430, 0x8410, 0x8410, 0x8410, 0x8410, 0x8410, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0,
+			0x001F, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F,
+			0x001F, 0x00FB, 0x06E3, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x4608, 0x8430, 0x8410, 0x8410, 0x4208, 0x0000, 0x0000,
+			0xF800, 0xF800, 0xE882, 0x8430, 0x8430, 0x8410, 0x8410, 0x8410, 0x8410, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0,
+			0x001F, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F,
+			0x001F, 0x001F, 0x00FB, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x8430, 0x8430, 0x8430, 0x0000, 0x0000, 0x0000,
+			0xF800, 0xE882, 0x8B8E, 0x8410, 0x8430, 0x8410, 0x8410, 0x8410, 0x8410, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0,
+			0x03EF, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x7BFF, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F,
+			0x001F, 0x001F, 0x001F, 0x03EF, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x8430, 0x8430, 0x8430, 0x0000, 0x0000, 0x0000,
+			0xE882, 0x8B8E, 0x8410, 0x45E8, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x8410, 0x8410, 0x8410, 0xF800, 0xF800, 0x1EE0,
+			0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0xF800, 0xF800, 0xFBEF, 0xFFFF, 0xFFFF, 0xFFFF, 0xF820, 0xF820, 0xF820,
+			0x07E0, 0x07E0, 0x07E0, 0x001F, 0x00FB, 0x06E3, 0x07E0, 0x07E0, 0x07E0, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000,
+			0x8B8E, 0x8410, 0x8410, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x8410, 0x8410, 0x8B8E, 0xF800, 0xF800, 0xD8E0,
+			0x3DE0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0xF800, 0xF800, 0xF800, 0xFFFF, 0xFFFF, 0xFFFF, 0xF820, 0xF820, 0xF820,
+			0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000,
+			0x8410, 0x8410, 0x8410, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x8410, 0x8B8E, 0xBA08, 0xF800, 0xF800, 0xF800,
+			0xF800, 0xBA00, 0x3DE0, 0x07E0, 0x07E0, 0x07E0, 0xF800, 0xF800, 0xF800, 0xFFFF, 0xFFFF, 0xFFFF, 0xF820, 0xF820, 0xF820,
+			0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000,
+			0x4217, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000, 0xF820, 0xF820, 0xF800, 0x7800, 0x0000, 0x7800,
+			0xF800, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0xFFFF, 0xF800, 0xF800, 0xF800, 0x8430, 0x8430, 0x8430, 0xF820, 0xF820, 0xF820,
+			0x8410, 0x8410, 0x8410, 0x8410, 0x8430, 0x8430, 0x0000, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF, 0x8410, 0x8410, 0x8410,
+			0x001F, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000, 0xF820, 0xF820, 0xF820, 0x0000, 0x0000, 0x0000,
+			0xF820, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0xFFFF, 0xF800, 0xF800, 0xF800, 0x8430, 0x8430, 0x8430, 0xF820, 0xF820, 0xF820,
+			0x8410, 0x8410, 0x8410, 0x8410, 0x8430, 0x8430, 0x0000, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF, 0x8410, 0x8410, 0x8410,
+			0x001F, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000, 0xF820, 0xF820, 0xF820, 0x7800, 0x0000, 0x7800,
+			0xF820, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0xFFFF, 0xF800, 0xF800, 0xBA08, 0x8430, 0x8430, 0x8430, 0xF820, 0xF820, 0xF820,
+			0x8410, 0x8410, 0x8410, 0x8410, 0x8430, 0x8430, 0x0000, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF, 0x8410, 0x8410, 0x8410,
+			0xF820, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x8410, 0x8410, 0xBA08, 0xF820, 0xF820, 0xF820,
+			0xBA08, 0x8410, 0x8410, 0x07E0, 0x07E0, 0x07E0, 0x8430, 0x8430, 0x8430, 0x4208, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF,
+			0x8410, 0x8410, 0x8410, 0xBDF7, 0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x07E0, 0xF800, 0xF800, 0xF800, 0x8410, 0x8410, 0x8410,
+			0xF820, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x8410, 0x8410, 0x8410, 0xF820, 0xF820, 0xF820,
+			0x8410, 0x8410, 0x8410, 0x07E0, 0x07E0, 0x07E0, 0x8430, 0x8430, 0x8430, 0x0000, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF,
+			0x8410, 0x8410, 0x8410, 0xFFFF, 0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x07E0, 0xF800, 0xF800, 0xF800, 0x8410, 0x8410, 0x8410,
+			0xF800, 0xF800, 0xF800, 0x07E0, 0x07E0, 0x07E0, 0x03EF, 0x001F, 0x001F, 0x8410, 0x8410, 0xBA08, 0xF820, 0xF820, 0xF820,
+			0x8410, 0x8410, 0x45E8, 0x07E0, 0x07E0, 0x07E0, 0x8430, 0x8430, 0x8430, 0x0000, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF,
+			0x8410, 0x8410, 0x8410, 0xFFFF, 0xFFFF, 0x7FEF, 0x07E0, 0x07E0, 0x07E0, 0xF800, 0xF800, 0xF800, 0xBA08, 0x8410, 0x8410,
+			0xF800, 0xF800, 0xF800, 0x8410, 0x8410, 0x45E8, 0x07E0, 0x07E0, 0x07E0, 0xF820, 0xF820, 0xF820, 0xF903, 0xFFFF, 0xFFFF,
+			0x07E0, 0x07E0, 0x07E0, 0x03EF, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0xFFFF, 0xFFFF, 0xFFFF,
+			0xF820, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x07E0, 0x45E8, 0x746E, 0x8410, 0x0000, 0x0000, 0x7800, 0xF800, 0xF800, 0xF800,
+			0xF800, 0xF800, 0xF800, 0x8410, 0x8410, 0x8410, 0x07E0, 0x07E0, 0x1EE0, 0xF820, 0xF820, 0xF903, 0xFEFB, 0xFFFF, 0xFFFF,
+			0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0xFFFF, 0xFFFF, 0xFFFF,
+			0xF820, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x07E0, 0x746E, 0x8410, 0x8410, 0x0000, 0x0000, 0x0000, 0xF800, 0xF800, 0xF800,
+			0xF800, 0xF800, 0xF800, 0x8410, 0x8410, 0x8410, 0x07E0, 0x1EE0, 0x7BE0, 0xF800, 0xF903, 0xFEFB, 0xFFFF, 0xFFFF, 0xFFFF,
+			0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0xFFFF, 0xFFFF, 0xFFFF,
+			0xFC0F, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x07E0, 0x8410, 0x8410, 0x8410, 0x4208, 0x0000, 0x0000, 0xF800, 0xF800, 0xF800,
+			0xF800, 0xF800, 0xF800, 0x001F, 0x001F, 0x001F, 0xF800, 0xF800, 0xF800, 0xF903, 0xFEFB, 0xFFFF, 0xBE17, 0x8430, 0x8430,
+			0xF820, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x0000, 0x0000, 0x7BEF,
+			0xFFFF, 0xFFFF, 0xFFFF, 0x001F, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xBDF7, 0x8410, 0x8430, 0x8430, 0x001F, 0x001F, 0x001F,
+			0xF800, 0xF800, 0xF800, 0x001F, 0x001F, 0x001F, 0xF800, 0xF800, 0xF800, 0xFEFB, 0xFFFF, 0xFFFF, 0x8430, 0x8430, 0x8430,
+			0xF820, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x0000, 0x0000, 0x0000,
+			0xFFFF, 0xFFFF, 0xFFFF, 0x001F, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF, 0x8430, 0x8430, 0x8430, 0x001F, 0x001F, 0x001F,
+			0xF800, 0xF800, 0xF800, 0x001F, 0x001F, 0x001F, 0xF800, 0xF800, 0xF800, 0xFBEF, 0xFEFB, 0xFFFF, 0x8430, 0x8430, 0xBA28,
+			0xF820, 0xF820, 0xF820, 0xFFFF, 0xFFFF, 0xFFFF, 0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x0000, 0x0000, 0x0000,
+			0xFFFF, 0xFFFF, 0xFFFF, 0x001F, 0x001F, 0x001F, 0xFFFF, 0xFFFF, 0xFFFF, 0x8430, 0x8430, 0x8430, 0x001F, 0x001F, 0x001F,
+			0xFBEF, 0xFEFB, 0xFFFF, 0x0000, 0x0000, 0x0000, 0xF800, 0xF800, 0xF800, 0xF800, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820,
+			0xF820, 0xF820, 0xF820, 0x8430, 0x8430, 0x8430, 0x8430, 0x8430, 0x8430, 0xF820, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x07E0,
+			0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x0000, 0x0000, 0x0000,
+			0xFEFB, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820,
+			0xF820, 0xF820, 0xF820, 0x8430, 0x8430, 0x8430, 0x8430, 0x8430, 0x8430, 0xF820, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x07E0,
+			0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x0000, 0x0000, 0x0000,
+			0xFFFF, 0xFFFF, 0xFFFF, 0x7BEF, 0x0000, 0x0000, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820, 0xF820,
+			0xF820, 0xF820, 0xF800, 0xBA08, 0x8430, 0x8430, 0x8430, 0x8430, 0x8430, 0xBA28, 0xF820, 0xF820, 0x07E0, 0x07E0, 0x07E0,
+			0x07E0, 0x07E0, 0x07E0, 0x001F, 0x001F, 0x001F, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x07E0, 0x0000, 0x0000, 0x0000,
+		};
+
+		checkScaler(HQ3x, 3, hq3xReference);
+#endif
+	}
+
+	void test_wide_rows() {
+#ifdef USE_HQ_SCALERS
+		// Rows wider than HQRowBuffers::kMaxStackWidth use heap buffers.
+		// Scaling such a row at once has to give the same result as
+		// scaling it in two halves, which both fit on the stack.
+		const int width = HQRowBuffers::kMaxStackWidth + 60;
+		const int height = 3;
+		const int srcPitch = width + 2;
+		const int dstPitch = width * 2;
+		uint16 *image = new uint16[srcPitch * (height + 2)];
+		uint16 *whole = new uint16[dstPitch * height * 2];
+		uint16 *halves = new uint16[dstPitch * height * 2];
+
+		uint32 seed = 1;
+		for (int i = 0; i < srcPitch * (height + 2); ++i) {
+			seed = seed * 1103515245 + 12345;
+			image[i] = (seed >> 16) & 1 ? 0xFFFF : 0x8410;
+		}
+
+		InitScalers(565);
+		const uint16 *src = image + srcPitch + 1;
+		HQ2x((const uint8 *)src, srcPitch * 2, (uint8 *)whole, dstPitch * 2, width, height);
+		HQ2x((const uint8 *)src, srcPitch * 2, (uint8 *)halves, dstPitch * 2, width / 2, height);
+		HQ2x((const uint8 *)(src + width / 2), srcPitch * 2, (uint8 *)(halves + width), dstPitch * 2, width / 2, height);
+		DestroyScalers();
+
+		TS_ASSERT(memcmp(whole, halves, dstPitch * height * 2 * sizeof(uint16)) == 0);
+
+		delete[] image;
+		delete[] whole;
+		delete[] halves;
+#endif
+	}
+};
@@ -0,0 +1,127 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/util.h"
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite
+{
+private:
+	// Reference implementation, computing the same values as the lookup tables
+	static uint32 referencePixel(const Graphics::PixelFormat &format, byte y, byte u, byte v) {
+		const int16 cr = v - 128;
+		const int16 cb = u - 128;
+		const int r = y + (int16)((0.419 / 0.299) * cr);
+		const int g = y + (int16)(-(0.299 / 0.419) * cr) + (int16)(-(0.114 / 0.331) * cb);
+		const int b = y + (int16)((0.587 / 0.331) * cb);
+		return format.RGBToColor(CLIP(r, 0, 255), CLIP(g, 0, 255), CLIP(b, 0, 255));
+	}
+
+	static uint32 getPixel(const Graphics::Surface &surface, int x, int y) {
+		if (surface.format.bytesPerPixel == 2)
+			return *(const uint16 *)surface.getBasePtr(x, y);
+		return *(const uint32 *)surface.getBasePtr(x, y);
+	}
+
+	// Fill a plane with random values, with a bias towards the extremes so
+	// that clamping is exercised
+	static void fillPlane(uint32 &seed, byte *plane, int size) {
+		for (int i = 0; i < size; ++i) {
+			seed = seed * 1103515245 + 12345;
+			const uint value = (seed >> 16) % 320;
+			plane[i] = (value < 32) ? 0 : (value >= 288) ? 255 : value - 32;
+		}
+	}
+
+	static Graphics::PixelFormat getFormat(int i) {
+		switch (i) {
+		case 0:
+			return Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		case 1:
+			return Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15);
+		case 2:
+			return Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		default:
+			return Graphics::PixelFormat(4, 8, 8, 8, 0, 24, 16, 8, 0);
+		}
+	}
+
+public:
+	void test_yuv444() {
+		// Use a width which is not a multiple of the vector size, and which
+		// is converted in more than one chunk
+		const int width = 301, height = 5, yPitch = 304, uvPitch = 305;
+		byte yPlane[yPitch * height], uPlane[uvPitch * height], vPlane[uvPitch * height];
+		uint32 seed = 1;
+
+		for (int f = 0; f < 4; ++f) {
+			fillPlane(seed, yPlane, sizeof(yPlane));
+			fillPlane(seed, uPlane, sizeof(uPlane));
+			fillPlane(seed, vPlane, sizeof(vPlane));
+
+			Graphics::Surface surface;
+			surface.create(width, height, getFormat(f));
+			Graphics::convertYUV444ToRGB(&surface, yPlane, uPlane, vPlane, width, height, yPitch, uvPitch);
+
+			for (int y = 0; y < height; ++y)
+				for (int x = 0; x < width; ++x)
+					TS_ASSERT_EQUALS(getPixel(surface, x, y), referencePixel(surface.format, yPlane[y * yPitch + x], uPlane[y * uvPitch + x], vPlane[y * uvPitch + x]));
+
+			surface.free();
+		}
+	}
+
+	void test_yuv420() {
+		const int width = 302, height = 6, yPitch = 304, uvPitch = 153;
+		byte yPlane[yPitch * height], uPlane[uvPitch * height / 2], vPlane[uvPitch * height / 2];
+		uint32 seed = 2;
+
+		for (int f = 0; f < 4; ++f) {
+			fillPlane(seed, yPlane, sizeof(yPlane));
+			fillPlane(seed, uPlane, sizeof(uPlane));
+			fillPlane(seed, vPlane, sizeof(vPlane));
+
+			Graphics::Surface surface;
+			surface.create(width, height, getFormat(f));
+			Graphics::convertYUV420ToRGB(&surface, yPlane, uPlane, vPlane, width, height, yPitch, uvPitch);
+
+			for (int y = 0; y < height; ++y)
+				for (int x = 0; x < width; ++x)
+					TS_ASSERT_EQUALS(getPixel(surface, x, y), referencePixel(surface.format, yPlane[y * yPitch + x], uPlane[(y / 2) * uvPitch + x / 2], vPlane[(y / 2) * uvPitch + x / 2]));
+
+			surface.free();
+		}
+	}
+
+	void test_yuv410() {
+		// The chroma planes need an extra row and column for the interpolation
+		const int width = 300, height = 8, yPitch = 300, uvPitch = 76;
+		byte yPlane[yPitch * height], uPlane[uvPitch * (height / 4 + 1)], vPlane[uvPitch * (height / 4 + 1)];
+		uint32 seed = 3;
+
+		for (int f = 0; f < 4; ++f) {
+			fillPlane(seed, yPlane, sizeof(yPlane));
+			fillPlane(seed, uPlane, sizeof(uPlane));
+			fillPlane(seed, vPlane, sizeof(vPlane));
+
+			Graphics::Surface surface;
+			surface.create(width, height, getFormat(f));
+			Graphics::convertYUV410ToRGB(&surface, yPlane, uPlane, vPlane, width, height, yPitch, uvPitch);
+
+			for (int y = 0; y < height; ++y) {
+				for (int x = 0; x < width; ++x) {
+					const int index = (y / 4) * uvPitch + x / 4;
+					const int xDiff = x & 3, yDiff = y & 3;
+					const byte u = (uPlane[index] * (4 - xDiff) * (4 - yDiff) + uPlane[index + 1] * xDiff * (4 - yDiff) +
+							uPlane[index + uvPitch] * yDiff * (4 - xDiff) + uPlane[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+					const byte v = (vPlane[index] * (4 - xDiff) * (4 - yDiff) + vPlane[index + 1] * xDiff * (4 - yDiff) +
+							vPlane[index + uvPitch] * yDiff * (4 - xDiff) + vPlane[index + uvPitch + 1] * xDiff * yDiff) >> 4;
+					TS_ASSERT_EQUALS(getPixel(surface, x, y), referencePixel(surface.format, yPlane[y * yPitch + x], u, v));
+				}
+			}
+
+			surface.free();
+		}
+	}
+};
@@ -5,8 +5,15 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
-TEST_LIBS    := audio/libaudio.a common/libcommon.a
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/graphics/*.h $(srcdir)/test/video/*.h
+TEST_LIBS    := video/libvideo.a audio/libaudio.a graphics/libgraphics.a common/libcommon.a
+
+ifeq ($(ENABLE_SCUMM), STATIC_PLUGIN)
+ifdef ENABLE_SCUMM_7_8
+TESTS        += $(srcdir)/test/engines/scumm/*.h
+TEST_LIBS    := engines/scumm/libscumm.a $(TEST_LIBS)
+endif
+endif
 
 #
 TEST_FLAGS   := --runner=StdioPrinter --no-std --no-eh --include=$(srcdir)/test/cxxtest_mingw.h
@@ -0,0 +1,218 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+
+#include "audio/mixer_intern.h"
+
+#include "graphics/surface.h"
+
+#include "video/avi_decoder.h"
+
+#include "helper.h"
+
+/**
+ * Builds an 8x4 MS RLE video of kFrameCount frames at 10 fps. The key frames
+ * fill the whole image with one color, the frames in between only change a
+ * single pixel, so a frame can only be decoded correctly by starting at the
+ * key frame before it.
+ */
+class AviTestVideo {
+public:
+	enum {
+		kWidth = 8,
+		kHeight = 4,
+		kFrameCount = 8,
+		kKeyFrameInterval = 4
+	};
+
+	static bool isKeyFrame(uint frame) {
+		return (frame % kKeyFrameInterval) == 0;
+	}
+
+	static Common::SeekableReadStream *create() {
+		Common::MemoryWriteStreamDynamic frames;
+		uint32 frameSizes[kFrameCount];
+
+		for (uint i = 0; i < kFrameCount; i++) {
+			const uint32 start = frames.size();
+
+			frames.writeUint32BE(MKTAG('0', '0', 'd', 'c'));
+			frames.writeUint32LE(0);
+
+			if (isKeyFrame(i)) {
+				for (int y = 0; y < kHeight; y++) {
+					frames.writeByte(kWidth);
+					frames.writeByte(i * 16);
+					frames.writeByte(0);
+					frames.writeByte(y == kHeight - 1 ? 1 : 0);	// End of image or line
+				}
+			} else {
+				frames.writeByte(0);
+				frames.writeByte(2);	// Skip to the pixel to change
+				frames.writeByte(i);
+				frames.writeByte(0);
+				frames.writeByte(1);
+				frames.writeByte(100 + i);
+				frames.writeByte(0);
+				frames.writeByte(1);	// End of image
+			}
+
+			frameSizes[i] = frames.size() - start - 8;
+			WRITE_LE_UINT32(frames.getData() + start + 4, frameSizes[i]);
+		}
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::NO);
+		const uint32 strfSize = 40 + 256 * 4;
+		const uint32 strlSize = 4 + (8 + 56) + (8 + strfSize);
+		const uint32 hdrlSize = 4 + (8 + 56) + (8 + strlSize);
+		const uint32 moviSize = 4 + frames.size();
+		const uint32 idx1Size = kFrameCount * 16;
+
+		out.writeUint32BE(ID_RIFF);
+		out.writeUint32LE(4 + (8 + hdrlSize) + (8 + moviSize) + (8 + idx1Size));
+		out.writeUint32BE(ID_AVI);
+
+		out.writeUint32BE(ID_LIST);
+		out.writeUint32LE(hdrlSize);
+		out.writeUint32BE(ID_HDRL);
+
+		out.writeUint32BE(ID_AVIH);
+		out.writeUint32LE(56);
+		out.writeUint32LE(100000);	// Microseconds per frame
+		out.writeUint32LE(0);
+		out.writeUint32LE(0);
+		out.writeUint32LE(Video::AVIF_HASINDEX);
+		out.writeUint32LE(kFrameCount);
+		out.writeUint32LE(0);
+		out.writeUint32LE(1);	// Streams
+		out.writeUint32LE(0);
+		out.writeUint32LE(kWidth);
+		out.writeUint32LE(kHeight);
+		for (int i = 0; i < 4; i++)
+			out.writeUint32LE(0);
+
+		out.writeUint32BE(ID_LIST);
+		out.writeUint32LE(strlSize);
+		out.writeUint32BE(ID_STRL);
+
+		out.writeUint32BE(ID_STRH);
+		out.writeUint32LE(56);
+		out.writeUint32BE(ID_VIDS);
+		out.writeUint32BE(ID_RLE);
+		out.writeUint32LE(0);
+		out.writeUint16LE(0);
+		out.writeUint16LE(0);
+		out.writeUint32LE(0);
+		out.writeUint32LE(1);	// Scale
+		out.writeUint32LE(10);	// Rate
+		out.writeUint32LE(0);
+		out.writeUint32LE(kFrameCount);
+		out.writeUint32LE(0);
+		out.writeUint32LE(0);
+		out.writeUint32LE(0);
+		out.writeUint32LE(0);	// Frame rectangle
+		out.writeUint32LE(0);
+
+		out.writeUint32BE(ID_STRF);
+		out.writeUint32LE(strfSize);
+		out.writeUint32LE(40);
+		out.writeUint32LE(kWidth);
+		out.writeUint32LE(kHeight);
+		out.writeUint16LE(1);
+		out.writeUint16LE(8);
+		out.writeUint32BE(ID_RLE);
+		for (int i = 0; i < 5; i++)
+			out.writeUint32LE(0);
+		for (int i = 0; i < 256; i++)
+			out.writeUint32LE(i * 0x010101);
+
+		out.writeUint32BE(ID_LIST);
+		out.writeUint32LE(moviSize);
+		out.writeUint32BE(ID_MOVI);
+		out.write(frames.getData(), frames.size());
+
+		out.writeUint32BE(ID_IDX1);
+		out.writeUint32LE(idx1Size);
+		uint32 offset = 4;
+		for (uint i = 0; i < kFrameCount; i++) {
+			out.writeUint32BE(MKTAG('0', '0', 'd', 'c'));
+			out.writeUint32LE(isKeyFrame(i) ? Video::AVIIF_KEYFRAME : 0);
+			out.writeUint32LE(offset);
+			out.writeUint32LE(frameSizes[i]);
+			offset += 8 + frameSizes[i];
+		}
+
+		free(frames.getData());
+		return new Common::MemoryReadStream(out.getData(), out.size(), DisposeAfterUse::YES);
+	}
+};
+
+class AviDecoderTestSuite : public CxxTest::TestSuite
+{
+private:
+	byte _reference[AviTestVideo::kFrameCount][AviTestVideo::kWidth * AviTestVideo::kHeight];
+
+	// Decode the whole video in order, which is what seeking has to match
+	void decodeReference(Audio::Mixer *mixer) {
+		Video::AviDecoder decoder(mixer);
+		TS_ASSERT(decoder.loadStream(AviTestVideo::create()));
+
+		for (int i = 0; i < AviTestVideo::kFrameCount; i++) {
+			const Graphics::Surface *frame = decoder.decodeNextFrame();
+			TS_ASSERT(frame);
+			if (frame)
+				memcpy(_reference[i], frame->pixels, sizeof(_reference[i]));
+		}
+
+		TS_ASSERT(decoder.endOfVideo());
+	}
+
+	bool isFrame(const Graphics::Surface *surface, int frameNum) {
+		return surface && surface->pitch == AviTestVideo::kWidth &&
+			memcmp(surface->pixels, _reference[frameNum], sizeof(_reference[frameNum])) == 0;
+	}
+
+public:
+	void test_seek_to_key_frame() {
+		TestVideoSystem system;
+		Audio::MixerImpl mixer(&system, 22050);
+		decodeReference(&mixer);
+
+		Video::AviDecoder decoder(&mixer);
+		TS_ASSERT(decoder.loadStream(AviTestVideo::create()));
+		TS_ASSERT(decoder.decodeNextFrame());
+
+		decoder.seekToTime(400);
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 4));
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 4);
+		TS_ASSERT_EQUALS(decoder.getElapsedTime(), 400u);
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 5));
+
+		// Back to the first frame
+		decoder.seekToTime(0);
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 0));
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 0);
+	}
+
+	void test_seek_between_key_frames() {
+		TestVideoSystem system;
+		Audio::MixerImpl mixer(&system, 22050);
+		decodeReference(&mixer);
+
+		Video::AviDecoder decoder(&mixer);
+		TS_ASSERT(decoder.loadStream(AviTestVideo::create()));
+
+		// A time in the middle of frame 6, which depends on frames 4 and 5
+		decoder.seekToTime(650);
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 6));
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 6);
+		TS_ASSERT_EQUALS(decoder.getElapsedTime(), 600u);
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 100u);
+
+		// Backwards, across a key frame
+		decoder.seekToTime(300);
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 3));
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 3);
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 4));
+	}
+};
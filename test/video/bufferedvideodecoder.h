@@ -0,0 +1,159 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/rational.h"
+
+#include "graphics/surface.h"
+
+#include "video/video_decoder.h"
+
+#include "helper.h"
+
+/**
+ * A video of kFrameCount frames at 10 fps, whose pixels are all set to the
+ * number of the frame.
+ */
+class NumberedFrameDecoder : public Video::FixedRateVideoDecoder {
+public:
+	enum {
+		kFrameCount = 6,
+		kWidth = 4,
+		kHeight = 2
+	};
+
+	NumberedFrameDecoder() : _loaded(true) {
+		_surface.create(kWidth, kHeight, Graphics::PixelFormat::createFormatCLUT8());
+	}
+
+	~NumberedFrameDecoder() {
+		_surface.free();
+	}
+
+	bool loadStream(Common::SeekableReadStream *stream) { return false; }
+	void close() { _loaded = false; reset(); }
+	bool isVideoLoaded() const { return _loaded; }
+
+	uint16 getWidth() const { return kWidth; }
+	uint16 getHeight() const { return kHeight; }
+	Graphics::PixelFormat getPixelFormat() const { return _surface.format; }
+	uint32 getFrameCount() const { return kFrameCount; }
+
+	const Graphics::Surface *decodeNextFrame() {
+		if (endOfVideo())
+			return 0;
+
+		if (++_curFrame == 0)
+			_startTime = g_system->getMillis();
+
+		memset(_surface.pixels, _curFrame, kWidth * kHeight);
+		return &_surface;
+	}
+
+protected:
+	Common::Rational getFrameRate() const { return 10; }
+
+private:
+	Graphics::Surface _surface;
+	bool _loaded;
+};
+
+class BufferedVideoDecoderTestSuite : public CxxTest::TestSuite
+{
+private:
+	static bool isFrame(const Graphics::Surface *surface, byte frameNum) {
+		if (!surface || surface->w != NumberedFrameDecoder::kWidth || surface->h != NumberedFrameDecoder::kHeight)
+			return false;
+
+		for (int y = 0; y < surface->h; y++) {
+			const byte *row = (const byte *)surface->getBasePtr(0, y);
+			for (int x = 0; x < surface->w; x++) {
+				if (row[x] != frameNum)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+public:
+	void test_frame_order() {
+		TestVideoSystem system;
+		Video::BufferedVideoDecoder decoder(new NumberedFrameDecoder(), 3);
+
+		// Fill the buffer completely before taking out any frames
+		TS_ASSERT(decoder.decodeAhead());
+		TS_ASSERT(decoder.decodeAhead());
+		TS_ASSERT(decoder.decodeAhead());
+		TS_ASSERT(!decoder.decodeAhead());
+		TS_ASSERT_EQUALS(decoder.getBufferedFrameCount(), 3u);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), -1);
+
+		for (int i = 0; i < NumberedFrameDecoder::kFrameCount; i++) {
+			const Graphics::Surface *frame = decoder.decodeNextFrame();
+			TS_ASSERT(isFrame(frame, i));
+			TS_ASSERT_EQUALS(decoder.getCurFrame(), i);
+
+			// Refill the slot which just became free
+			decoder.decodeAhead();
+		}
+	}
+
+	void test_due_times() {
+		TestVideoSystem system;
+		Video::BufferedVideoDecoder decoder(new NumberedFrameDecoder(), 3);
+
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 0));
+
+		// Decoding ahead must not change when the queued frames are due
+		while (decoder.decodeAhead())
+			;
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 100u);
+		TS_ASSERT(!decoder.needsUpdate());
+
+		system.advance(60);
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 40u);
+
+		system.advance(40);
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 0u);
+		TS_ASSERT(decoder.needsUpdate());
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 1));
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 100u);
+
+		// Time spent paused doesn't count
+		decoder.pauseVideo(true);
+		system.advance(500);
+		decoder.pauseVideo(false);
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 100u);
+
+		// Frames decoded late are due right away
+		system.advance(250);
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 0u);
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 2));
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 0u);
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 3));
+		TS_ASSERT_EQUALS(decoder.getTimeToNextFrame(), 50u);
+	}
+
+	void test_end_of_video() {
+		TestVideoSystem system;
+		Video::BufferedVideoDecoder decoder(new NumberedFrameDecoder(), 5);
+
+		TS_ASSERT(!decoder.endOfVideo());
+		TS_ASSERT(isFrame(decoder.decodeNextFrame(), 0));
+
+		// All remaining frames fit into the buffer, so the wrapped decoder
+		// reaches its end while the last frames still have to be shown
+		while (decoder.decodeAhead())
+			;
+		TS_ASSERT_EQUALS(decoder.getBufferedFrameCount(), 5u);
+
+		for (int i = 1; i < NumberedFrameDecoder::kFrameCount; i++) {
+			TS_ASSERT(!decoder.endOfVideo());
+			TS_ASSERT(isFrame(decoder.decodeNextFrame(), i));
+		}
+
+		TS_ASSERT(decoder.endOfVideo());
+		TS_ASSERT_EQUALS(decoder.getBufferedFrameCount(), 0u);
+		TS_ASSERT(!decoder.decodeAhead());
+		TS_ASSERT(decoder.decodeNextFrame() == 0);
+	}
+};
@@ -0,0 +1,169 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/util.h"
+
+#include "graphics/surface.h"
+
+#include "video/codecs/cinepak.h"
+
+#include "helper.h"
+
+/**
+ * Builds an 8x4 Cinepak frame of two blocks. The first one is a V1 block,
+ * the second one a V4 block, and the codebook entries include colors which
+ * need clipping.
+ */
+class CinepakTestFrame {
+public:
+	enum {
+		kWidth = 8,
+		kHeight = 4,
+		kEntries = 4
+	};
+
+	static byte getY(int entry, int i) { return (entry * 67 + i * 53 + 3) & 0xFF; }
+	static byte getU(int entry) { return (entry * 0x45 + 0x10) & 0xFF; }
+	static byte getV(int entry) { return (entry * 0x9B + 0x70) & 0xFF; }
+
+	static Common::SeekableReadStream *create() {
+		Common::MemoryWriteStreamDynamic chunks;
+
+		// The V1 and V4 codebooks, with signed chroma
+		writeCodebook(chunks, 0x22);
+		writeCodebook(chunks, 0x20);
+
+		// One flag bit per block, a clear bit selects V1
+		chunks.writeByte(0x30);
+		chunks.writeByte(0);
+		chunks.writeUint16BE(4 + 4 + 1 + 4);
+		chunks.writeUint32BE(0x40000000);
+		chunks.writeByte(1);
+		for (int i = 0; i < 4; i++)
+			chunks.writeByte(i);
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::NO);
+		const uint32 length = 10 + 12 + chunks.size();
+		out.writeByte(0);
+		out.writeByte(length >> 16);
+		out.writeUint16BE(length & 0xFFFF);
+		out.writeUint16BE(kWidth);
+		out.writeUint16BE(kHeight);
+		out.writeUint16BE(1);	// Strips
+
+		out.writeUint16BE(0x1000);
+		out.writeUint16BE(12 + chunks.size());
+		out.writeUint16BE(0);
+		out.writeUint16BE(0);
+		out.writeUint16BE(kHeight);
+		out.writeUint16BE(kWidth);
+		out.write(chunks.getData(), chunks.size());
+
+		free(chunks.getData());
+		return new Common::MemoryReadStream(out.getData(), out.size(), DisposeAfterUse::YES);
+	}
+
+	/** The codebook entry and luma index of a pixel */
+	static void getSource(int x, int y, int &entry, int &i) {
+		const int quadrant = (y >> 1) * 2 + ((x >> 1) & 1);
+
+		if (x < 4) {
+			// V1: each luma value covers a 2x2 square
+			entry = 1;
+			i = quadrant;
+		} else {
+			// V4: each entry covers a 2x2 square
+			entry = quadrant;
+			i = (y & 1) * 2 + (x & 1);
+		}
+	}
+
+private:
+	static void writeCodebook(Common::WriteStream &out, byte chunkID) {
+		out.writeByte(chunkID);
+		out.writeByte(0);
+		out.writeUint16BE(4 + kEntries * 6);
+
+		for (int entry = 0; entry < kEntries; entry++) {
+			for (int i = 0; i < 4; i++)
+				out.writeByte(getY(entry, i));
+			out.writeByte(getU(entry));
+			out.writeByte(getV(entry));
+		}
+	}
+};
+
+class CinepakDecoderTestSuite : public CxxTest::TestSuite
+{
+private:
+	// The color of a pixel, converted the way the decoder always did
+	static uint32 getColor(const Graphics::PixelFormat &format, int entry, int i) {
+		const byte y = CinepakTestFrame::getY(entry, i);
+
+		if (format.bytesPerPixel == 1)
+			return y;
+
+		const int u = (byte)(CinepakTestFrame::getU(entry) + 128);
+		const int v = (byte)(CinepakTestFrame::getV(entry) + 128);
+
+		const byte r = CLIP<int>(y + 2 * (v - 128), 0, 255);
+		const byte g = CLIP<int>(y - (u - 128) / 2 - (v - 128), 0, 255);
+		const byte b = CLIP<int>(y + 2 * (u - 128), 0, 255);
+		return format.RGBToColor(r, g, b);
+	}
+
+	void checkFrame(int bitsPerPixel) {
+		Video::CinepakDecoder decoder(bitsPerPixel);
+		Common::SeekableReadStream *stream = CinepakTestFrame::create();
+		const Graphics::Surface *surface = decoder.decodeImage(stream);
+		delete stream;
+
+		TS_ASSERT(surface);
+		if (!surface)
+			return;
+
+		const Graphics::PixelFormat format = decoder.getPixelFormat();
+		TS_ASSERT_EQUALS(surface->w, CinepakTestFrame::kWidth);
+		TS_ASSERT_EQUALS(surface->h, CinepakTestFrame::kHeight);
+		TS_ASSERT_EQUALS(surface->format.bytesPerPixel, format.bytesPerPixel);
+
+		for (int y = 0; y < CinepakTestFrame::kHeight; y++) {
+			for (int x = 0; x < CinepakTestFrame::kWidth; x++) {
+				const byte *src = (const byte *)surface->getBasePtr(x, y);
+				uint32 color;
+				if (format.bytesPerPixel == 1)
+					color = *src;
+				else if (format.bytesPerPixel == 2)
+					color = *(const uint16 *)src;
+				else
+					color = *(const uint32 *)src;
+
+				int entry, i;
+				CinepakTestFrame::getSource(x, y, entry, i);
+				TS_ASSERT_EQUALS(color, getColor(format, entry, i));
+			}
+		}
+	}
+
+public:
+	void test_decode_8bpp() {
+		TestVideoSystem system;
+		checkFrame(8);
+	}
+
+	void test_decode_16bpp() {
+#ifdef USE_RGB_COLOR
+		TestVideoSystem system;
+		system.setScreenFormat(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		checkFrame(24);
+#endif
+	}
+
+	void test_decode_32bpp() {
+#ifdef USE_RGB_COLOR
+		TestVideoSystem system;
+		system.setScreenFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		checkFrame(24);
+#endif
+	}
+};
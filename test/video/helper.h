@@ -0,0 +1,83 @@
+#ifndef TEST_VIDEO_HELPER_H
+#define TEST_VIDEO_HELPER_H
+
+#include "common/system.h"
+#include "common/list.h"
+
+#include "graphics/pixelformat.h"
+
+/**
+ * A minimal OSystem whose clock only advances when told to, so that the
+ * timing of the video decoders can be tested. Install it by constructing
+ * it, and it uninstalls itself again when destroyed.
+ */
+class TestVideoSystem : public OSystem {
+public:
+	TestVideoSystem() : _millis(1000), _prevSystem(g_system) {
+		g_system = this;
+#ifdef USE_RGB_COLOR
+		_screenFormat = Graphics::PixelFormat::createFormatCLUT8();
+#endif
+	}
+	~TestVideoSystem() { g_system = _prevSystem; }
+
+	void advance(uint32 msecs) { _millis += msecs; }
+#ifdef USE_RGB_COLOR
+	void setScreenFormat(const Graphics::PixelFormat &format) { _screenFormat = format; }
+#endif
+
+	uint32 getMillis() { return _millis; }
+	void delayMillis(uint msecs) { _millis += msecs; }
+	void getTimeAndDate(TimeDate &t) const { memset(&t, 0, sizeof(t)); }
+
+	const GraphicsMode *getSupportedGraphicsModes() const { return 0; }
+	int getDefaultGraphicsMode() const { return 0; }
+	bool setGraphicsMode(int mode) { return false; }
+	int getGraphicsMode() const { return 0; }
+#ifdef USE_RGB_COLOR
+	Graphics::PixelFormat getScreenFormat() const { return _screenFormat; }
+	Common::List<Graphics::PixelFormat> getSupportedFormats() const { return Common::List<Graphics::PixelFormat>(); }
+#endif
+	void initSize(uint width, uint height, const Graphics::PixelFormat *format) {}
+	int16 getHeight() { return 0; }
+	int16 getWidth() { return 0; }
+	PaletteManager *getPaletteManager() { return 0; }
+	void copyRectToScreen(const byte *buf, int pitch, int x, int y, int w, int h) {}
+	Graphics::Surface *lockScreen() { return 0; }
+	void unlockScreen() {}
+	void fillScreen(uint32 col) {}
+	void updateScreen() {}
+	void setShakePos(int shakeOffset) {}
+
+	void showOverlay() {}
+	void hideOverlay() {}
+	Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	void clearOverlay() {}
+	void grabOverlay(OverlayColor *buf, int pitch) {}
+	void copyRectToOverlay(const OverlayColor *buf, int pitch, int x, int y, int w, int h) {}
+	int16 getOverlayHeight() { return 0; }
+	int16 getOverlayWidth() { return 0; }
+
+	bool showMouse(bool visible) { return false; }
+	void warpMouse(int x, int y) {}
+	void setMouseCursor(const byte *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, int cursorTargetScale, const Graphics::PixelFormat *format) {}
+
+	MutexRef createMutex() { return 0; }
+	void lockMutex(MutexRef mutex) {}
+	void unlockMutex(MutexRef mutex) {}
+	void deleteMutex(MutexRef mutex) {}
+
+	Audio::Mixer *getMixer() { return 0; }
+	void quit() {}
+	void displayMessageOnOSD(const char *msg) {}
+	void logMessage(LogMessageType::Type type, const char *message) {}
+
+private:
+	uint32 _millis;
+	OSystem *_prevSystem;
+#ifdef USE_RGB_COLOR
+	Graphics::PixelFormat _screenFormat;
+#endif
+};
+
+#endif
@@ -0,0 +1,170 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/util.h"
+
+#include "graphics/conversion.h"
+#include "graphics/surface.h"
+
+#include "video/codecs/indeo3.h"
+
+#include "helper.h"
+
+/**
+ * Builds a 64x16 Indeo 3 intra frame. Each plane is one strip in which every
+ * 4x4 block is filled with a single value, so that the chroma differs
+ * between the blocks and has to be interpolated at their borders.
+ */
+class Indeo3TestFrame {
+public:
+	enum {
+		kWidth = 64,
+		kHeight = 16,
+		kChromaWidth = 16,
+		kChromaHeight = 4
+	};
+
+	static byte getY(int x, int y) { return (((x >> 2) * 37 + (y >> 2) * 91) & 0x7F) << 1; }
+	static byte getU(int x, int y) { return (((x >> 2) * 29 + (y >> 2) * 11 + 5) & 0x7F) << 1; }
+	static byte getV(int x, int y) { return (((x >> 2) * 53 + (y >> 2) * 17 + 90) & 0x7F) << 1; }
+
+	static Common::SeekableReadStream *create() {
+		Common::MemoryWriteStreamDynamic planes;
+
+		// The plane read with the U offset ends up as V and vice versa
+		const uint32 offsY = 48 + planes.size();
+		writePlane(planes, kWidth, kHeight, getY);
+		const uint32 offsU = 48 + planes.size();
+		writePlane(planes, kChromaWidth, kChromaHeight, getV);
+		const uint32 offsV = 48 + planes.size();
+		writePlane(planes, kChromaWidth, kChromaHeight, getU);
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::NO);
+		const uint32 size = 48 + planes.size();
+		out.writeUint32LE(MKTAG('F','R','M','H') ^ size);
+		out.writeUint32LE(0);
+		out.writeUint32LE(0);
+		out.writeUint32LE(size);
+		out.writeUint16LE(0);
+		out.writeUint16LE(0);	// flags1: decode into the first buffer
+		out.writeUint32LE(0);	// flags3
+		out.writeByte(0);	// flags2
+		out.writeByte(0);
+		out.writeUint16LE(0);
+		out.writeUint16LE(kHeight);
+		out.writeUint16LE(kWidth);
+		out.writeUint32LE(offsY - 16);
+		out.writeUint32LE(offsU - 16);
+		out.writeUint32LE(offsV - 16);
+		out.writeUint32LE(0);
+		out.write(planes.getData(), planes.size());
+
+		free(planes.getData());
+		return new Common::MemoryReadStream(out.getData(), out.size(), DisposeAfterUse::YES);
+	}
+
+private:
+	static void writePlane(Common::WriteStream &out, int width, int height, byte (*value)(int, int)) {
+		out.writeUint32LE(0);	// The commands follow directly
+		out.writeByte(0xB0);	// No motion vectors, intra coded leaf
+		out.writeByte(0x00);	// No prediction, correction table 0
+
+		for (int y = 0; y < height; y += 4) {
+			for (int x = 0; x < width; x += 4) {
+				out.writeByte(0xF8);	// Fill the block
+				out.writeByte(value(x, y) >> 1);
+			}
+		}
+	}
+};
+
+class Indeo3DecoderTestSuite : public CxxTest::TestSuite
+{
+private:
+	// The chroma of the row below the last one is the border of the next
+	// buffer, which is always 0x80
+	static byte getChroma(byte (*value)(int, int), int x, int y) {
+		if (y >= Indeo3TestFrame::kChromaHeight)
+			return 0x80;
+		return value(x, y);
+	}
+
+	// The color of a pixel, converted the way the decoder always did
+	static uint32 getColor(const Graphics::PixelFormat &format, int x, int y) {
+		const int chromaX = x >> 2;
+		const int chromaY = y >> 2;
+
+		int neighborX = chromaX;
+		if ((x & 3) == 0)
+			neighborX = MAX<int>(chromaX - 1, 0);
+		else if ((x & 3) == 3)
+			neighborX = MIN<int>(chromaX + 1, Indeo3TestFrame::kChromaWidth - 1);
+
+		// Only the row below is ever interpolated with
+		const int neighborY = ((y & 3) == 3) ? chromaY + 1 : chromaY;
+
+		const byte u = (getChroma(Indeo3TestFrame::getU, chromaX, chromaY) + getChroma(Indeo3TestFrame::getU, neighborX, neighborY)) / 2;
+		const byte v = (getChroma(Indeo3TestFrame::getV, chromaX, chromaY) + getChroma(Indeo3TestFrame::getV, neighborX, neighborY)) / 2;
+
+		byte r, g, b;
+		Graphics::YUV2RGB(Indeo3TestFrame::getY(x, y), u, v, r, g, b);
+		return format.RGBToColor(r, g, b);
+	}
+
+	void checkFrame() {
+		Video::Indeo3Decoder decoder(Indeo3TestFrame::kWidth, Indeo3TestFrame::kHeight);
+		Common::SeekableReadStream *stream = Indeo3TestFrame::create();
+		TS_ASSERT(Video::Indeo3Decoder::isIndeo3(*stream));
+		stream->seek(0);
+		const Graphics::Surface *surface = decoder.decodeImage(stream);
+		delete stream;
+
+		TS_ASSERT(surface);
+		if (!surface)
+			return;
+
+		const Graphics::PixelFormat format = decoder.getPixelFormat();
+		TS_ASSERT_EQUALS(surface->format.bytesPerPixel, format.bytesPerPixel);
+
+		for (int y = 0; y < Indeo3TestFrame::kHeight; y++) {
+			for (int x = 0; x < Indeo3TestFrame::kWidth; x++) {
+				const byte *src = (const byte *)surface->getBasePtr(x, y);
+				uint32 color;
+				if (format.bytesPerPixel == 1)
+					color = *src;
+				else if (format.bytesPerPixel == 2)
+					color = *(const uint16 *)src;
+				else
+					color = *(const uint32 *)src;
+
+				TS_ASSERT_EQUALS(color, getColor(format, x, y));
+			}
+		}
+	}
+
+public:
+	void test_decode_8bpp() {
+		TestVideoSystem system;
+#ifdef USE_RGB_COLOR
+		// A format which actually holds colors, unlike CLUT8
+		system.setScreenFormat(Graphics::PixelFormat(1, 3, 3, 2, 0, 5, 2, 0, 0));
+#endif
+		checkFrame();
+	}
+
+	void test_decode_16bpp() {
+#ifdef USE_RGB_COLOR
+		TestVideoSystem system;
+		system.setScreenFormat(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		checkFrame();
+#endif
+	}
+
+	void test_decode_32bpp() {
+#ifdef USE_RGB_COLOR
+		TestVideoSystem system;
+		system.setScreenFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		checkFrame();
+#endif
+	}
+};
@@ -0,0 +1,239 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/memstream.h"
+
+#include "audio/mixer_intern.h"
+
+#include "graphics/surface.h"
+
+#include "video/smk_decoder.h"
+
+#include "helper.h"
+
+/**
+ * Builds a 16x8 Smacker v2 video of kFrameCount frames at 10 fps. Frame n
+ * fills block n and skips all others, and sets palette entry n + 1 while
+ * keeping the rest of the palette. Smacker has no key frames, so every frame
+ * can only be decoded correctly by starting at the first one.
+ */
+class SmackerTestVideo {
+public:
+	enum {
+		kWidth = 16,
+		kHeight = 8,
+		kFrameCount = 8,
+		kFillColor = 0x20
+	};
+
+	static Common::SeekableReadStream *create() {
+		// Only the type tree is used, the other trees are empty. It maps
+		// code 0 to a skip and code 1 to a fill with kFillColor, both with a
+		// run of a single block.
+		BitWriter trees;
+		trees.write(0, 1);	// MMap
+		trees.write(0, 1);	// MClr
+		trees.write(0, 1);	// Full
+		trees.write(1, 1);	// Type
+		writeSmallTree(trees, 0x02, 0x03);	// Low bytes: skip, fill
+		writeSmallTree(trees, 0x00, kFillColor);	// High bytes: none, color
+		trees.write(0x1111, 16);	// Unused markers
+		trees.write(0x2222, 16);
+		trees.write(0x3333, 16);
+		trees.write(1, 1);	// Node
+		trees.write(0, 1);	// Leaf 0x0002
+		trees.write(0, 1);
+		trees.write(0, 1);
+		trees.write(0, 1);	// Leaf 0x2003
+		trees.write(1, 1);
+		trees.write(1, 1);
+		trees.write(0, 1);
+		trees.pad();
+
+		Common::MemoryWriteStreamDynamic frames;
+		uint32 frameSizes[kFrameCount];
+
+		for (uint i = 0; i < kFrameCount; i++) {
+			const uint32 start = frames.size();
+
+			// Palette record: skip the entries up to i, set entry i + 1 and
+			// skip the remaining ones
+			frames.writeByte(2);	// Length in 4 byte units
+			frames.writeByte(0x80 | i);
+			frames.writeByte(i + 1);
+			frames.writeByte(i * 2);
+			frames.writeByte(i * 3);
+			uint left = 256 - (i + 2);
+			while (left > 0) {
+				const uint skip = MIN<uint>(left, 128);
+				frames.writeByte(0x80 | (skip - 1));
+				left -= skip;
+			}
+			while (frames.size() - start < 8)
+				frames.writeByte(0);
+
+			BitWriter video;
+			for (uint block = 0; block < kFrameCount; block++)
+				video.write(block == i ? 1 : 0, 1);
+			video.pad();
+			frames.write(video.getData(), video.size());
+			while ((frames.size() - start) % 4)
+				frames.writeByte(0);
+
+			frameSizes[i] = frames.size() - start;
+		}
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::NO);
+		out.writeUint32BE(MKTAG('S', 'M', 'K', '2'));
+		out.writeUint32LE(kWidth);
+		out.writeUint32LE(kHeight);
+		out.writeUint32LE(kFrameCount);
+		out.writeSint32LE(100);	// Milliseconds per frame
+		out.writeUint32LE(0);	// Flags
+		for (int i = 0; i < 7; i++)
+			out.writeUint32LE(0);	// Audio sizes
+		out.writeUint32LE(trees.size());
+		out.writeUint32LE(0);	// MMap size
+		out.writeUint32LE(0);	// MClr size
+		out.writeUint32LE(0);	// Full size
+		out.writeUint32LE(6 * 4);	// Type size: three nodes plus three markers
+		for (int i = 0; i < 7; i++)
+			out.writeUint32LE(0);	// Audio info
+		out.writeUint32LE(0);
+		for (uint i = 0; i < kFrameCount; i++)
+			out.writeUint32LE(frameSizes[i]);
+		for (uint i = 0; i < kFrameCount; i++)
+			out.writeByte(1);	// Palette, no audio
+		out.write(trees.getData(), trees.size());
+		out.write(frames.getData(), frames.size());
+
+		free(frames.getData());
+		return new Common::MemoryReadStream(out.getData(), out.size(), DisposeAfterUse::YES);
+	}
+
+private:
+	// Writes bits least significant first, as read by BitStream8LSB
+	class BitWriter {
+	public:
+		BitWriter() : _bits(0) {}
+
+		void write(uint32 value, int count) {
+			for (int i = 0; i < count; i++, _bits++) {
+				if ((_bits & 7) == 0)
+					_data.push_back(0);
+				if (value & (1 << i))
+					_data.back() |= 1 << (_bits & 7);
+			}
+		}
+
+		// Leave some zero bytes, as the Huffman trees peek ahead
+		void pad() {
+			for (int i = 0; i < 4; i++)
+				_data.push_back(0);
+		}
+
+		const byte *getData() const { return _data.begin(); }
+		uint size() const { return _data.size(); }
+
+	private:
+		Common::Array<byte> _data;
+		uint _bits;
+	};
+
+	// A tree holding two bytes, with codes 0 and 1
+	static void writeSmallTree(BitWriter &bits, byte value0, byte value1) {
+		bits.write(1, 1);
+		bits.write(1, 1);	// Node
+		bits.write(0, 1);
+		bits.write(value0, 8);
+		bits.write(0, 1);
+		bits.write(value1, 8);
+		bits.write(0, 1);
+	}
+};
+
+class SmackerDecoderTestSuite : public CxxTest::TestSuite
+{
+private:
+	byte _reference[SmackerTestVideo::kFrameCount][SmackerTestVideo::kWidth * SmackerTestVideo::kHeight];
+	byte _referencePalette[SmackerTestVideo::kFrameCount][3 * 256];
+
+	// Decode the whole video in order, which is what seeking has to match
+	void decodeReference(Audio::Mixer *mixer) {
+		Video::SmackerDecoder decoder(mixer);
+		TS_ASSERT(decoder.loadStream(SmackerTestVideo::create()));
+
+		for (int i = 0; i < SmackerTestVideo::kFrameCount; i++) {
+			const Graphics::Surface *frame = decoder.decodeNextFrame();
+			TS_ASSERT(frame);
+			if (frame)
+				memcpy(_reference[i], frame->pixels, sizeof(_reference[i]));
+			memcpy(_referencePalette[i], decoder.getPalette(), sizeof(_referencePalette[i]));
+		}
+
+		TS_ASSERT(decoder.endOfVideo());
+
+		// The frames really do depend on each other
+		TS_ASSERT_EQUALS(_reference[SmackerTestVideo::kFrameCount - 1][0], SmackerTestVideo::kFillColor);
+		TS_ASSERT_EQUALS(_referencePalette[SmackerTestVideo::kFrameCount - 1][3], 4);
+	}
+
+	bool isFrame(Video::SmackerDecoder &decoder, const Graphics::Surface *surface, int frameNum) {
+		return surface && surface->pitch == SmackerTestVideo::kWidth &&
+			memcmp(surface->pixels, _reference[frameNum], sizeof(_reference[frameNum])) == 0 &&
+			memcmp(decoder.getPalette(), _referencePalette[frameNum], sizeof(_referencePalette[frameNum])) == 0;
+	}
+
+public:
+	void test_seek_forwards() {
+		TestVideoSystem system;
+		Audio::MixerImpl mixer(&system, 22050);
+		decodeReference(&mixer);
+
+		Video::SmackerDecoder decoder(&mixer);
+		TS_ASSERT(decoder.loadStream(SmackerTestVideo::create()));
+		TS_ASSERT(isFrame(decoder, decoder.decodeNextFrame(), 0));
+
+		// Skips over frames 1 to 5 without displaying them
+		decoder.seekToTime(650);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 5);
+		TS_ASSERT(isFrame(decoder, decoder.decodeNextFrame(), 6));
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 6);
+		TS_ASSERT_EQUALS(decoder.getElapsedTime(), 600u);
+		TS_ASSERT(isFrame(decoder, decoder.decodeNextFrame(), 7));
+
+		// Seeking to the next frame must not restart
+		decoder.seekToTime(0);
+		decoder.decodeNextFrame();
+		decoder.seekToTime(100);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 0);
+		TS_ASSERT(isFrame(decoder, decoder.decodeNextFrame(), 1));
+	}
+
+	void test_seek_backwards() {
+		TestVideoSystem system;
+		Audio::MixerImpl mixer(&system, 22050);
+		decodeReference(&mixer);
+
+		Video::SmackerDecoder decoder(&mixer);
+		TS_ASSERT(decoder.loadStream(SmackerTestVideo::create()));
+		for (int i = 0; i < 6; i++)
+			TS_ASSERT(isFrame(decoder, decoder.decodeNextFrame(), i));
+
+		// Restarts from the first frame, which must not keep the blocks and
+		// palette entries of the later frames
+		decoder.seekToTime(200);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), 1);
+		TS_ASSERT(isFrame(decoder, decoder.decodeNextFrame(), 2));
+		TS_ASSERT_EQUALS(decoder.getElapsedTime(), 200u);
+		TS_ASSERT(isFrame(decoder, decoder.decodeNextFrame(), 3));
+
+		// The frame just decoded
+		decoder.seekToTime(300);
+		TS_ASSERT(isFrame(decoder, decoder.decodeNextFrame(), 3));
+
+		decoder.seekToTime(0);
+		TS_ASSERT_EQUALS(decoder.getCurFrame(), -1);
+		TS_ASSERT(isFrame(decoder, decoder.decodeNextFrame(), 0));
+	}
+};
@@ -56,6 +56,10 @@ static uint16 getStreamType(uint32 tag) {
 	return tag & 0xffff;
 }
 
+static bool isVideoChunk(uint16 streamType) {
+	return streamType == 'dc' || streamType == 'id' || streamType == 'AM' || streamType == '32' || streamType == 'iv';
+}
+
 AviDecoder::AviDecoder(Audio::Mixer *mixer, Audio::Mixer::SoundType soundType) : _mixer(mixer) {
 	_soundType = soundType;
 
@@ -65,7 +69,12 @@ AviDecoder::AviDecoder(Audio::Mixer *mixer, Audio::Mixer::SoundType soundType) :
 	_fileStream = NULL;
 	_audHandle = new Audio::SoundHandle();
 	_dirtyPalette = false;
+	_audioChunk = 0;
+	_nextAudioChunk = 0;
+	_audioSkipSamples = 0;
+	_audioTimeOffset = 0;
 	memset(_palette, 0, sizeof(_palette));
+	memset(_initialPalette, 0, sizeof(_initialPalette));
 	memset(&_wvInfo, 0, sizeof(PCMWAVEFORMAT));
 	memset(&_bmInfo, 0, sizeof(BITMAPINFOHEADER));
 	memset(&_vidsHeader, 0, sizeof(AVIStreamHeader));
@@ -121,6 +130,11 @@ void AviDecoder::runHandle(uint32 tag) {
 			} break;
 		case ID_IDX1:
 			_ixInfo.size = _fileStream->readUint32LE();
+			if (_ixInfo.indices) {
+				// Already read when loading
+				_fileStream->skip(_ixInfo.size);
+				break;
+			}
 			_ixInfo.indices = new AVIOLDINDEX::Index[_ixInfo.size / 16];
 			debug (0, "%d Indices", (_ixInfo.size / 16));
 			for (uint32 i = 0; i < (_ixInfo.size / 16); i++) {
@@ -248,14 +262,23 @@ bool AviDecoder::loadStream(Common::SeekableReadStream *stream) {
 		nextTag = _fileStream->readUint32BE();
 	}
 
-	// Ignore the 'movi' LIST
+	// Index the 'movi' LIST, for seeking
 	if (nextTag == ID_LIST) {
-		_fileStream->readUint32BE(); // Skip size
+		uint32 moviSize = _fileStream->readUint32LE();
+		uint32 moviStart = _fileStream->pos();
 		if (_fileStream->readUint32BE() != ID_MOVI)
 			error ("Expected 'movi' LIST");
+
+		buildIndex(moviStart, moviStart + moviSize);
 	} else
 		error ("Expected 'movi' LIST");
 
+	memcpy(_initialPalette, _palette, sizeof(_palette));
+	_audioChunk = 0;
+	_nextAudioChunk = 0;
+	_audioSkipSamples = 0;
+	_audioTimeOffset = 0;
+
 	// Now, create the codec
 	_videoCodec = createCodec();
 
@@ -295,7 +318,12 @@ void AviDecoder::close() {
 	delete[] _ixInfo.indices;
 	_ixInfo.indices = 0;
 
+	_videoIndex.clear();
+	_audioIndex.clear();
+	_paletteIndex.clear();
+
 	memset(_palette, 0, sizeof(_palette));
+	memset(_initialPalette, 0, sizeof(_initialPalette));
 	memset(&_wvInfo, 0, sizeof(PCMWAVEFORMAT));
 	memset(&_bmInfo, 0, sizeof(BITMAPINFOHEADER));
 	memset(&_vidsHeader, 0, sizeof(AVIStreamHeader));
@@ -307,7 +335,7 @@ void AviDecoder::close() {
 
 uint32 AviDecoder::getElapsedTime() const {
 	if (_audStream)
-		return _mixer->getSoundElapsedTime(*_audHandle);
+		return _audioTimeOffset + _mixer->getSoundElapsedTime(*_audHandle);
 
 	return FixedRateVideoDecoder::getElapsedTime();
 }
@@ -343,9 +371,7 @@ const Graphics::Surface *AviDecoder::decodeNextFrame() {
 		uint32 chunkSize = _fileStream->readUint32LE();
 		queueAudioBuffer(chunkSize);
 		_fileStream->skip(chunkSize & 1); // Alignment
-	} else if (getStreamType(nextTag) == 'dc' || getStreamType(nextTag) == 'id' ||
-	           getStreamType(nextTag) == 'AM' || getStreamType(nextTag) == '32' ||
-			   getStreamType(nextTag) == 'iv') {
+	} else if (isVideoChunk(getStreamType(nextTag))) {
 		// Compressed Frame
 		_curFrame++;
 		uint32 chunkSize = _fileStream->readUint32LE();
@@ -360,25 +386,7 @@ const Graphics::Surface *AviDecoder::decodeNextFrame() {
 		return surface;
 	} else if (getStreamType(nextTag) == 'pc') {
 		// Palette Change
-		_fileStream->readUint32LE(); // Chunk size, not needed here
-		byte firstEntry = _fileStream->readByte();
-		uint16 numEntries = _fileStream->readByte();
-		_fileStream->readUint16LE(); // Reserved
-
-		// 0 entries means all colors are going to be changed
-		if (numEntries == 0)
-			numEntries = 256;
-
-		for (uint16 i = firstEntry; i < numEntries + firstEntry; i++) {
-			_palette[i * 3] = _fileStream->readByte();
-			_palette[i * 3 + 1] = _fileStream->readByte();
-			_palette[i * 3 + 2] = _fileStream->readByte();
-			_fileStream->readByte(); // Flags that don't serve us any purpose
-		}
-
-		_dirtyPalette = true;
-
-		// No alignment necessary. It's always even.
+		handlePalChange();
 	} else if (nextTag == ID_JUNK) {
 		runHandle(ID_JUNK);
 	} else if (nextTag == ID_IDX1) {
@@ -389,6 +397,180 @@ const Graphics::Surface *AviDecoder::decodeNextFrame() {
 	return NULL;
 }
 
+void AviDecoder::handlePalChange() {
+	_fileStream->readUint32LE(); // Chunk size, not needed here
+	byte firstEntry = _fileStream->readByte();
+	uint16 numEntries = _fileStream->readByte();
+	_fileStream->readUint16LE(); // Reserved
+
+	// 0 entries means all colors are going to be changed
+	if (numEntries == 0)
+		numEntries = 256;
+
+	for (uint16 i = firstEntry; i < numEntries + firstEntry; i++) {
+		_palette[i * 3] = _fileStream->readByte();
+		_palette[i * 3 + 1] = _fileStream->readByte();
+		_palette[i * 3 + 2] = _fileStream->readByte();
+		_fileStream->readByte(); // Flags that don't serve us any purpose
+	}
+
+	_dirtyPalette = true;
+
+	// No alignment necessary. It's always even.
+}
+
+void AviDecoder::buildIndex(uint32 moviStart, uint32 moviEnd) {
+	uint32 endPos = MIN<uint32>(moviEnd, _fileStream->size());
+	uint32 audioSamples = 0;
+
+	_fileStream->seek(moviStart + 4);
+
+	while (_fileStream->pos() + 8 <= (int32)endPos) {
+		uint32 offset = _fileStream->pos();
+		uint32 tag = _fileStream->readUint32BE();
+		uint32 chunkSize = _fileStream->readUint32LE();
+
+		if (tag == ID_LIST) {
+			// Index the chunks inside 'rec ' lists too
+			_fileStream->skip(4);
+			continue;
+		}
+
+		uint16 streamType = getStreamType(tag);
+
+		if (streamType == 'wb') {
+			AudioIndexEntry entry = { offset, audioSamples };
+			_audioIndex.push_back(entry);
+			audioSamples += getAudioChunkSamples(chunkSize);
+		} else if (isVideoChunk(streamType)) {
+			// The first frame is always a key frame
+			VideoIndexEntry entry = { offset, _videoIndex.empty() };
+			_videoIndex.push_back(entry);
+		} else if (streamType == 'pc') {
+			_paletteIndex.push_back(offset);
+		}
+
+		_fileStream->skip(chunkSize + (chunkSize & 1));
+	}
+
+	// The key frames are flagged in the 'idx1' chunk following the 'movi' LIST.
+	// Without it, seeking has to decode from the first frame.
+	_fileStream->seek(moviEnd);
+
+	if (_fileStream->pos() + 8 <= _fileStream->size() && _fileStream->readUint32BE() == ID_IDX1) {
+		runHandle(ID_IDX1);
+
+		uint32 frame = 0;
+		for (uint32 i = 0; i < (_ixInfo.size / 16) && frame < _videoIndex.size(); i++) {
+			if (isVideoChunk(getStreamType(_ixInfo.indices[i].id))) {
+				if (_ixInfo.indices[i].flags & AVIIF_KEYFRAME)
+					_videoIndex[frame].keyFrame = true;
+				frame++;
+			}
+		}
+	}
+
+	_fileStream->seek(moviStart + 4);
+}
+
+uint32 AviDecoder::getAudioChunkSamples(uint32 chunkSize) const {
+	if (_wvInfo.tag == kWaveFormatPCM && _wvInfo.blockAlign)
+		return chunkSize / _wvInfo.blockAlign;
+
+	if (_wvInfo.avgBytesPerSec)
+		return (uint32)((double)chunkSize * _wvInfo.samplesPerSec / _wvInfo.avgBytesPerSec);
+
+	return 0;
+}
+
+void AviDecoder::seekToTime(Audio::Timestamp time) {
+	if (_videoIndex.empty())
+		return;
+
+	uint32 frame = MIN<uint32>(getFrameAtTime(time.msecs()), _videoIndex.size() - 1);
+	uint32 frameTime = getFrameBeginTime(frame);
+
+	// Decoding has to start at the last key frame up to the frame seeked to
+	uint32 keyFrame = frame;
+	while (keyFrame > 0 && !_videoIndex[keyFrame].keyFrame)
+		keyFrame--;
+
+	uint32 offset = _videoIndex[keyFrame].offset;
+
+	// Restore the palette as it was at the key frame
+	memcpy(_palette, _initialPalette, sizeof(_palette));
+	for (uint32 i = 0; i < _paletteIndex.size() && _paletteIndex[i] < offset; i++) {
+		_fileStream->seek(_paletteIndex[i] + 4);
+		handlePalChange();
+	}
+
+	_dirtyPalette = true;
+
+	// Find the first audio chunk following the key frame
+	_audioChunk = 0;
+	while (_audioChunk < _audioIndex.size() && _audioIndex[_audioChunk].offset < offset)
+		_audioChunk++;
+
+	_nextAudioChunk = _audioChunk;
+	_audioSkipSamples = 0;
+
+	if (_audStream) {
+		// The mixer will delete the stream
+		_mixer->stopHandle(*_audHandle);
+		_audStream = createAudioStream();
+		_audioTimeOffset = frameTime;
+
+		uint32 sample = (uint32)((double)frameTime * _wvInfo.samplesPerSec / 1000);
+
+		// Audio usually leads the video, so the audio at the new position
+		// may be stored before the key frame. Queue these chunks first.
+		uint32 firstChunk = 0;
+		while (firstChunk + 1 < _audioIndex.size() && _audioIndex[firstChunk + 1].startSample <= sample)
+			firstChunk++;
+
+		firstChunk = MIN(firstChunk, _audioChunk);
+
+		if (firstChunk < _audioIndex.size()) {
+			_audioSkipSamples = sample - MIN(sample, _audioIndex[firstChunk].startSample);
+
+			uint32 keyFrameChunk = _audioChunk;
+			_nextAudioChunk = firstChunk;
+
+			for (_audioChunk = firstChunk; _audioChunk < keyFrameChunk; ) {
+				_fileStream->seek(_audioIndex[_audioChunk].offset + 4);
+				queueAudioBuffer(_fileStream->readUint32LE());
+			}
+		}
+	}
+
+	// Decode everything up to the frame before the one seeked to
+	_fileStream->seek(offset);
+	_curFrame = keyFrame - 1;
+
+	while (_curFrame < (int32)frame - 1 && !_fileStream->eos())
+		decodeNextFrame();
+
+	if (_audStream) {
+		_mixer->playStream(_soundType, _audHandle, _audStream);
+
+		// Pause the audio again if we're still paused
+		if (isPaused())
+			_mixer->pauseHandle(*_audHandle, true);
+	}
+
+	_startTime = g_system->getMillis() - frameTime;
+	resetPauseStartTime();
+}
+
+void AviDecoder::pauseVideoIntern(bool pause) {
+	if (_audStream)
+		_mixer->pauseHandle(*_audHandle, pause);
+}
+
+uint32 AviDecoder::getDuration() const {
+	return getFrameBeginTime(getFrameCount());
+}
+
 Codec *AviDecoder::createCodec() {
 	switch (_vidsHeader.streamHandler) {
 		case ID_CRAM:
@@ -427,13 +609,19 @@ Audio::QueuingAudioStream *AviDecoder::createAudioStream() {
 }
 
 void AviDecoder::queueAudioBuffer(uint32 chunkSize) {
-	// Return if we haven't created the queue (unsupported audio format)
-	if (!_audStream) {
+	uint32 chunk = _audioChunk++;
+
+	// Return if we haven't created the queue (unsupported audio format), or
+	// if the chunk has already been queued when seeking
+	if (!_audStream || chunk < _nextAudioChunk) {
 		_fileStream->skip(chunkSize);
 		return;
 	}
 
+	_nextAudioChunk = chunk + 1;
+
 	Common::SeekableReadStream *stream = _fileStream->readStream(chunkSize);
+	Audio::AudioStream *audioStream;
 
 	if (_wvInfo.tag == kWaveFormatPCM) {
 		byte flags = 0;
@@ -445,10 +633,27 @@ void AviDecoder::queueAudioBuffer(uint32 chunkSize) {
 		if (_wvInfo.channels == 2)
 			flags |= Audio::FLAG_STEREO;
 
-		_audStream->queueAudioStream(Audio::makeRawStream(stream, _wvInfo.samplesPerSec, flags, DisposeAfterUse::YES), DisposeAfterUse::YES);
-	} else if (_wvInfo.tag == kWaveFormatDK3) {
-		_audStream->queueAudioStream(Audio::makeADPCMStream(stream, DisposeAfterUse::YES, chunkSize, Audio::kADPCMDK3, _wvInfo.samplesPerSec, _wvInfo.channels, _wvInfo.blockAlign), DisposeAfterUse::YES);
+		audioStream = Audio::makeRawStream(stream, _wvInfo.samplesPerSec, flags, DisposeAfterUse::YES);
+	} else {
+		audioStream = Audio::makeADPCMStream(stream, DisposeAfterUse::YES, chunkSize, Audio::kADPCMDK3, _wvInfo.samplesPerSec, _wvInfo.channels, _wvInfo.blockAlign);
 	}
+
+	// Drop the audio before the time seeked to
+	int16 buffer[1024];
+	int channels = (_wvInfo.channels == 2) ? 2 : 1;
+
+	while (_audioSkipSamples > 0 && !audioStream->endOfData()) {
+		int samples = audioStream->readBuffer(buffer, MIN<uint32>(_audioSkipSamples * channels, ARRAYSIZE(buffer)));
+		if (samples <= 0)
+			break;
+
+		_audioSkipSamples -= MIN<uint32>(samples / channels, _audioSkipSamples);
+	}
+
+	if (audioStream->endOfData())
+		delete audioStream;
+	else
+		_audStream->queueAudioStream(audioStream, DisposeAfterUse::YES);
 }
 
 } // End of namespace Video
@@ -23,6 +23,7 @@
 #ifndef VIDEO_AVI_PLAYER_H
 #define VIDEO_AVI_PLAYER_H
 
+#include "common/array.h"
 #include "common/endian.h"
 #include "common/rational.h"
 #include "common/rect.h"
@@ -124,7 +125,7 @@ struct AVIOLDINDEX {
 
 // Index Flags
 enum IndexFlags {
-	AVIIF_INDEX = 0x10
+	AVIIF_KEYFRAME = 0x10
 };
 
 // Audio Codecs
@@ -182,7 +183,7 @@ struct AVIStreamHeader {
  * Video decoder used in engines:
  *  - sci
  */
-class AviDecoder : public FixedRateVideoDecoder {
+class AviDecoder : public FixedRateVideoDecoder, public SeekableVideoDecoder {
 public:
 	AviDecoder(Audio::Mixer *mixer,
 			Audio::Mixer::SoundType soundType = Audio::Mixer::kPlainSoundType);
@@ -201,8 +202,13 @@ public:
 	const byte *getPalette() { _dirtyPalette = false; return _palette; }
 	bool hasDirtyPalette() const { return _dirtyPalette; }
 
+	// SeekableVideoDecoder API
+	void seekToTime(Audio::Timestamp time);
+	uint32 getDuration() const;
+
 protected:
 	Common::Rational getFrameRate() const { return Common::Rational(_vidsHeader.rate, _vidsHeader.scale); }
+	void pauseVideoIntern(bool pause);
 
 private:
 	Audio::Mixer *_mixer;
@@ -213,6 +219,7 @@ private:
 	AVIStreamHeader _vidsHeader;
 	AVIStreamHeader _audsHeader;
 	byte _palette[3 * 256];
+	byte _initialPalette[3 * 256];
 	bool _dirtyPalette;
 
 	Common::SeekableReadStream *_fileStream;
@@ -232,6 +239,29 @@ private:
 	Audio::QueuingAudioStream *_audStream;
 	Audio::QueuingAudioStream *createAudioStream();
 	void queueAudioBuffer(uint32 chunkSize);
+
+	// Index of the chunks in the 'movi' list, built when loading
+	struct VideoIndexEntry {
+		uint32 offset;
+		bool keyFrame;
+	};
+
+	struct AudioIndexEntry {
+		uint32 offset;
+		uint32 startSample; ///< Position of the first sample of the chunk
+	};
+
+	Common::Array<VideoIndexEntry> _videoIndex;
+	Common::Array<AudioIndexEntry> _audioIndex;
+	Common::Array<uint32> _paletteIndex; ///< Offsets of the palette changes
+
+	uint32 _audioChunk;       ///< Index of the next audio chunk in the file
+	uint32 _nextAudioChunk;   ///< Index of the next audio chunk to queue
+	uint32 _audioSkipSamples; ///< Audio samples still to be dropped after a seek
+	uint32 _audioTimeOffset;  ///< Time (in ms) at which the audio stream starts
+
+	void buildIndex(uint32 moviStart, uint32 moviEnd);
+	uint32 getAudioChunkSamples(uint32 chunkSize) const;
 };
 
 } // End of namespace Video
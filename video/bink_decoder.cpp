@@ -34,7 +34,6 @@
 #include "common/file.h"
 #include "common/str.h"
 #include "common/bitstream.h"
-#include "common/huffman.h"
 #include "common/rdft.h"
 #include "common/dct.h"
 #include "common/system.h"
@@ -85,9 +84,6 @@ BinkDecoder::BinkDecoder() {
 	_bink = 0;
 	_audioTrack = 0;
 
-	for (int i = 0; i < 16; i++)
-		_huffman[i] = 0;
-
 	for (int i = 0; i < kSourceMAX; i++) {
 		_bundles[i].countLength = 0;
 
@@ -148,11 +144,6 @@ void BinkDecoder::close() {
 
 	deinitBundles();
 
-	for (int i = 0; i < 16; i++) {
-		delete _huffman[i];
-		_huffman[i] = 0;
-	}
-
 	delete _bink; _bink = 0;
 	_surface.free();
 
@@ -735,12 +726,31 @@ void BinkDecoder::deinitBundles() {
 }
 
 void BinkDecoder::initHuffman() {
-	for (int i = 0; i < 16; i++)
-		_huffman[i] = new Common::Huffman(binkHuffmanLengths[i][15], 16, binkHuffmanCodes[i], binkHuffmanLengths[i]);
+	memset(_huffmanLookup, -1, sizeof(_huffmanLookup));
+
+	for (int i = 0; i < 16; i++) {
+		for (int j = 0; j < 16; j++) {
+			assert(binkHuffmanLengths[i][j] <= kHuffmanMaxLength);
+			_huffmanLookup[i][(1 << binkHuffmanLengths[i][j]) | binkHuffmanCodes[i][j]] = j;
+		}
+	}
 }
 
 byte BinkDecoder::getHuffmanSymbol(VideoFrame &video, Huffman &huffman) {
-	return huffman.symbols[_huffman[huffman.index]->getSymbol(*video.bits)];
+	const int8 *lookup = _huffmanLookup[huffman.index];
+	uint32 code = 0;
+
+	// Bink codes are at most 7 bits long, so just try each length in turn
+	for (uint32 length = 0; length < kHuffmanMaxLength; length++) {
+		video.bits->addBit(code, length);
+
+		int8 symbol = lookup[(2 << length) | code];
+		if (symbol >= 0)
+			return huffman.symbols[symbol];
+	}
+
+	error("Unknown Huffman code");
+	return 0;
 }
 
 int32 BinkDecoder::getBundleValue(Source source) {
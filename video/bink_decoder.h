@@ -43,7 +43,6 @@
 namespace Common {
 	class SeekableReadStream;
 	class BitStream;
-	class Huffman;
 
 	class RDFT;
 	class DCT;
@@ -81,6 +80,7 @@ public:
 protected:
 	static const int kAudioChannelsMax  = 2;
 	static const int kAudioBlockSizeMax = (kAudioChannelsMax << 11);
+	static const int kHuffmanMaxLength  = 7;
 
 	/** IDs for different data types used in Bink video codec. */
 	enum Source {
@@ -235,7 +235,12 @@ protected:
 
 	uint32 _audioTrack; ///< Audio track to use.
 
-	Common::Huffman *_huffman[16]; ///< The 16 Huffman codebooks used in Bink decoding.
+	/**
+	 * The 16 Huffman codebooks used in Bink decoding, as lookup tables.
+	 * A code of length n is found at (1 << n) | code, and maps to the
+	 * index of its symbol, or -1 if there is no such code.
+	 */
+	int8 _huffmanLookup[16][1 << (kHuffmanMaxLength + 1)];
 
 	Bundle _bundles[kSourceMAX]; ///< Bundles for decoding all data types.
 
@@ -253,7 +258,7 @@ protected:
 	/** Deinitialize the bundles. */
 	void deinitBundles();
 
-	/** Initialize the Huffman decoders. */
+	/** Initialize the Huffman lookup tables. */
 	void initHuffman();
 
 	/** Decode an audio packet. */
@@ -261,7 +266,14 @@ protected:
 	/** Decode a video packet. */
 	virtual void videoPacket(VideoFrame &video);
 
-	/** Decode a plane. */
+	/**
+	 * Decode a plane.
+	 *
+	 * The planes of a frame are decoded one after the other, not in
+	 * parallel. They are read from the same bitstream, and the start of a
+	 * plane is only found by decoding the plane before it. All planes also
+	 * share the decoder's _bundles, _colHighHuffman and _colLastVal state.
+	 */
 	void decodePlane(VideoFrame &video, int planeIdx, bool isChroma);
 
 	/** Read/Initialize a bundle for decoding a plane. */
@@ -41,15 +41,13 @@ inline static void CPYUV2RGB(byte y, byte u, byte v, byte &r, byte &g, byte &b)
 	b = CLIP<int>(y + 2 * (u - 128), 0, 255);
 }
 
-#define PUT_PIXEL(offset, lum, u, v) \
-	if (_pixelFormat.bytesPerPixel != 1) { \
-		CPYUV2RGB(lum, u, v, r, g, b); \
-		if (_pixelFormat.bytesPerPixel == 2) \
-			*((uint16 *)_curFrame.surface->pixels + offset) = _pixelFormat.RGBToColor(r, g, b); \
-		else \
-			*((uint32 *)_curFrame.surface->pixels + offset) = _pixelFormat.RGBToColor(r, g, b); \
-	} else \
-		*((byte *)_curFrame.surface->pixels + offset) = lum
+#define PUT_PIXEL(offset, color) \
+	if (_pixelFormat.bytesPerPixel == 1) \
+		*((byte *)_curFrame.surface->pixels + offset) = color; \
+	else if (_pixelFormat.bytesPerPixel == 2) \
+		*((uint16 *)_curFrame.surface->pixels + offset) = color; \
+	else \
+		*((uint32 *)_curFrame.surface->pixels + offset) = color
 
 CinepakDecoder::CinepakDecoder(int bitsPerPixel) : Codec() {
 	_curFrame.surface = NULL;
@@ -200,6 +198,18 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream *stream, uint16 str
 				codebook[i].u  = 128;
 				codebook[i].v  = 128;
 			}
+
+			// Convert the colors once here instead of for every pixel
+			// drawn with this entry
+			for (byte j = 0; j < 4; j++) {
+				if (_pixelFormat.bytesPerPixel == 1) {
+					codebook[i].color[j] = codebook[i].y[j];
+				} else {
+					byte r = 0, g = 0, b = 0;
+					CPYUV2RGB(codebook[i].y[j], codebook[i].u, codebook[i].v, r, g, b);
+					codebook[i].color[j] = _pixelFormat.RGBToColor(r, g, b);
+				}
+			}
 		}
 	}
 }
@@ -208,7 +218,6 @@ void CinepakDecoder::decodeVectors(Common::SeekableReadStream *stream, uint16 st
 	uint32 flag = 0, mask = 0;
 	uint32 iy[4];
 	int32 startPos = stream->pos();
-	byte r = 0, g = 0, b = 0;
 
 	for (uint16 y = _curFrame.strips[strip].rect.top; y < _curFrame.strips[strip].rect.bottom; y += 4) {
 		iy[0] = _curFrame.strips[strip].rect.left + y * _curFrame.width;
@@ -239,54 +248,54 @@ void CinepakDecoder::decodeVectors(Common::SeekableReadStream *stream, uint16 st
 						return;
 
 					// Get the codebook
-					CinepakCodebook codebook = _curFrame.strips[strip].v1_codebook[stream->readByte()];
-
-					PUT_PIXEL(iy[0] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 1, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 1, codebook.y[0], codebook.u, codebook.v);
-
-					PUT_PIXEL(iy[0] + 2, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 3, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 2, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 3, codebook.y[1], codebook.u, codebook.v);
-
-					PUT_PIXEL(iy[2] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 1, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 1, codebook.y[2], codebook.u, codebook.v);
-
-					PUT_PIXEL(iy[2] + 2, codebook.y[3], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 3, codebook.y[3], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 2, codebook.y[3], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 3, codebook.y[3], codebook.u, codebook.v);
+					const CinepakCodebook *codebook = &_curFrame.strips[strip].v1_codebook[stream->readByte()];
+
+					PUT_PIXEL(iy[0] + 0, codebook->color[0]);
+					PUT_PIXEL(iy[0] + 1, codebook->color[0]);
+					PUT_PIXEL(iy[1] + 0, codebook->color[0]);
+					PUT_PIXEL(iy[1] + 1, codebook->color[0]);
+
+					PUT_PIXEL(iy[0] + 2, codebook->color[1]);
+					PUT_PIXEL(iy[0] + 3, codebook->color[1]);
+					PUT_PIXEL(iy[1] + 2, codebook->color[1]);
+					PUT_PIXEL(iy[1] + 3, codebook->color[1]);
+
+					PUT_PIXEL(iy[2] + 0, codebook->color[2]);
+					PUT_PIXEL(iy[2] + 1, codebook->color[2]);
+					PUT_PIXEL(iy[3] + 0, codebook->color[2]);
+					PUT_PIXEL(iy[3] + 1, codebook->color[2]);
+
+					PUT_PIXEL(iy[2] + 2, codebook->color[3]);
+					PUT_PIXEL(iy[2] + 3, codebook->color[3]);
+					PUT_PIXEL(iy[3] + 2, codebook->color[3]);
+					PUT_PIXEL(iy[3] + 3, codebook->color[3]);
 				} else if (flag & mask) {
 					if ((stream->pos() - startPos + 4) > (int32)chunkSize)
 						return;
 
-					CinepakCodebook codebook = _curFrame.strips[strip].v4_codebook[stream->readByte()];
-					PUT_PIXEL(iy[0] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 1, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 1, codebook.y[3], codebook.u, codebook.v);
-
-					codebook = _curFrame.strips[strip].v4_codebook[stream->readByte()];
-					PUT_PIXEL(iy[0] + 2, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[0] + 3, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 2, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[1] + 3, codebook.y[3], codebook.u, codebook.v);
-
-					codebook = _curFrame.strips[strip].v4_codebook[stream->readByte()];
-					PUT_PIXEL(iy[2] + 0, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 1, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 0, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 1, codebook.y[3], codebook.u, codebook.v);
-
-					codebook = _curFrame.strips[strip].v4_codebook[stream->readByte()];
-					PUT_PIXEL(iy[2] + 2, codebook.y[0], codebook.u, codebook.v);
-					PUT_PIXEL(iy[2] + 3, codebook.y[1], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 2, codebook.y[2], codebook.u, codebook.v);
-					PUT_PIXEL(iy[3] + 3, codebook.y[3], codebook.u, codebook.v);
+					const CinepakCodebook *codebook = &_curFrame.strips[strip].v4_codebook[stream->readByte()];
+					PUT_PIXEL(iy[0] + 0, codebook->color[0]);
+					PUT_PIXEL(iy[0] + 1, codebook->color[1]);
+					PUT_PIXEL(iy[1] + 0, codebook->color[2]);
+					PUT_PIXEL(iy[1] + 1, codebook->color[3]);
+
+					codebook = &_curFrame.strips[strip].v4_codebook[stream->readByte()];
+					PUT_PIXEL(iy[0] + 2, codebook->color[0]);
+					PUT_PIXEL(iy[0] + 3, codebook->color[1]);
+					PUT_PIXEL(iy[1] + 2, codebook->color[2]);
+					PUT_PIXEL(iy[1] + 3, codebook->color[3]);
+
+					codebook = &_curFrame.strips[strip].v4_codebook[stream->readByte()];
+					PUT_PIXEL(iy[2] + 0, codebook->color[0]);
+					PUT_PIXEL(iy[2] + 1, codebook->color[1]);
+					PUT_PIXEL(iy[3] + 0, codebook->color[2]);
+					PUT_PIXEL(iy[3] + 1, codebook->color[3]);
+
+					codebook = &_curFrame.strips[strip].v4_codebook[stream->readByte()];
+					PUT_PIXEL(iy[2] + 2, codebook->color[0]);
+					PUT_PIXEL(iy[2] + 3, codebook->color[1]);
+					PUT_PIXEL(iy[3] + 2, codebook->color[2]);
+					PUT_PIXEL(iy[3] + 3, codebook->color[3]);
 				}
 			}
 
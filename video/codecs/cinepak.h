@@ -38,6 +38,9 @@ namespace Video {
 struct CinepakCodebook {
 	byte y[4];
 	byte u, v;
+
+	// The four pixels in the output format
+	uint32 color[4];
 };
 
 struct CinepakStrip {
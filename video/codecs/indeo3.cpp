@@ -32,8 +32,9 @@
 #include "common/endian.h"
 #include "common/stream.h"
 #include "common/textconsole.h"
+#include "common/util.h"
 
-#include "graphics/conversion.h"
+#include "graphics/yuv_to_rgb.h"
 
 #include "video/codecs/indeo3.h"
 
@@ -260,7 +261,12 @@ const Graphics::Surface *Indeo3Decoder::decodeImage(Common::SeekableReadStream *
 
 	delete[] inData;
 
-	// Blit the frame onto the surface
+	convertToSurface(fWidth, fHeight, chromaWidth);
+
+	return _surface;
+}
+
+void Indeo3Decoder::convertToSurface(uint32 width, uint32 height, uint32 chromaWidth) {
 	const byte *srcY = _cur_frame->Ybuf;
 	const byte *srcU = _cur_frame->Ubuf;
 	const byte *srcV = _cur_frame->Vbuf;
@@ -271,64 +277,67 @@ const Graphics::Surface *Indeo3Decoder::decodeImage(Common::SeekableReadStream *
 	const byte *srcUN = srcU + chromaWidth;
 	const byte *srcVN = srcV + chromaWidth;
 
-	uint32 scaleWidth  = _surface->w / fWidth;
-	uint32 scaleHeight = _surface->h / fHeight;
+	uint32 scaleWidth  = _surface->w / width;
+	uint32 scaleHeight = _surface->h / height;
+
+	const uint32 bytesPerPixel = _surface->format.bytesPerPixel;
+
+	// The chroma terms of a row, and the converted row when scaling
+	int16 *terms = new int16[3 * width];
+	int16 *rTerms = terms;
+	int16 *gTerms = terms + width;
+	int16 *bTerms = terms + 2 * width;
+	byte *row = (scaleWidth > 1) ? new byte[width * bytesPerPixel] : 0;
+
+	for (uint32 y = 0; y < height; y++) {
+		// The chroma of the pixels at the border of a 4x4 block is averaged
+		// with the one of the neighboring block
+		const byte *srcUA = ((y & 3) == 0) ? srcUP : (((y & 3) == 3) ? srcUN : srcU);
+		const byte *srcVA = ((y & 3) == 0) ? srcVP : (((y & 3) == 3) ? srcVN : srcV);
+
+		for (uint32 x = 0; x < width; x++) {
+			uint32 xA = x >> 2;
+			if ((x & 3) == 0)
+				xA = MAX<int32>((x >> 2) - 1, 0);
+			else if ((x & 3) == 3)
+				xA = MIN<int32>((x >> 2) + 1, chromaWidth - 1);
+
+			int cU = ((srcU[x >> 2] + srcUA[xA]) >> 1) - 128;
+			int cV = ((srcV[x >> 2] + srcVA[xA]) >> 1) - 128;
+
+			// The same formula as Graphics::YUV2RGB()
+			rTerms[x] = (1357 * cV) >> 10;
+			gTerms[x] = -((691 * cV) >> 10) - ((333 * cU) >> 10);
+			bTerms[x] = (1715 * cU) >> 10;
+		}
 
-	for (uint32 y = 0; y < fHeight; y++) {
 		byte *rowDest = dest;
+		byte *convDest = (scaleWidth > 1) ? row : rowDest;
 
-		for (uint32 sH = 0; sH < scaleHeight; sH++) {
-			for (uint32 x = 0; x < fWidth; x++) {
-				uint32 xP = MAX<int32>((x >> 2) - 1, 0);
-				uint32 xN = MIN<int32>((x >> 2) + 1, chromaWidth - 1);
-
-				byte cY = srcY[x];
-				byte cU = srcU[x >> 2];
-				byte cV = srcV[x >> 2];
-
-				if        (((x % 4) == 0) && ((y % 4) == 0)) {
-					cU = (((uint32) cU) + ((uint32) srcUP[xP])) / 2;
-					cV = (((uint32) cV) + ((uint32) srcVP[xP])) / 2;
-				} else if (((x % 4) == 3) && ((y % 4) == 0)) {
-					cU = (((uint32) cU) + ((uint32) srcUP[xN])) / 2;
-					cV = (((uint32) cV) + ((uint32) srcVP[xN])) / 2;
-				} else if (((x % 4) == 0) && ((y % 4) == 3)) {
-					cU = (((uint32) cU) + ((uint32) srcUN[xP])) / 2;
-					cV = (((uint32) cV) + ((uint32) srcVN[xP])) / 2;
-				} else if (((x % 4) == 3) && ((y % 4) == 3)) {
-					cU = (((uint32) cU) + ((uint32) srcUN[xN])) / 2;
-					cV = (((uint32) cV) + ((uint32) srcVN[xN])) / 2;
-				} else if ( (x % 4) == 0) {
-					cU = (((uint32) cU) + ((uint32) srcU[xP])) / 2;
-					cV = (((uint32) cV) + ((uint32) srcV[xP])) / 2;
-				} else if ( (x % 4) == 3) {
-					cU = (((uint32) cU) + ((uint32) srcU[xN])) / 2;
-					cV = (((uint32) cV) + ((uint32) srcV[xN])) / 2;
-				} else if ( (y % 4) == 0) {
-					cU = (((uint32) cU) + ((uint32) srcUP[x >> 2])) / 2;
-					cV = (((uint32) cV) + ((uint32) srcVP[x >> 2])) / 2;
-				} else if ( (y % 4) == 3) {
-					cU = (((uint32) cU) + ((uint32) srcUN[x >> 2])) / 2;
-					cV = (((uint32) cV) + ((uint32) srcVN[x >> 2])) / 2;
-				}
-
-				byte r = 0, g = 0, b = 0;
-				Graphics::YUV2RGB(cY, cU, cV, r, g, b);
+		if (bytesPerPixel == 1) {
+			// No SIMD path for 8 bit surfaces, convert each pixel as before
+			for (uint32 x = 0; x < width; x++) {
+				byte r = CLIP<int>(srcY[x] + rTerms[x], 0, 255);
+				byte g = CLIP<int>(srcY[x] + gTerms[x], 0, 255);
+				byte b = CLIP<int>(srcY[x] + bTerms[x], 0, 255);
 
-				const uint32 color = _pixelFormat.RGBToColor(r, g, b);
-
-				for (uint32 sW = 0; sW < scaleWidth; sW++, rowDest += _surface->format.bytesPerPixel) {
-					if      (_surface->format.bytesPerPixel == 1)
-						*((uint8 *)rowDest) = (uint8)color;
-					else if (_surface->format.bytesPerPixel == 2)
-						*((uint16 *)rowDest) = (uint16)color;
-				}
+				convDest[x] = (uint8)_surface->format.RGBToColor(r, g, b);
 			}
+		} else
+			Graphics::convertYUVTermsToRGB(convDest, _surface->format, srcY, rTerms, gTerms, bTerms, width);
 
-			dest += _surface->pitch;
+		if (scaleWidth > 1) {
+			for (uint32 x = 0; x < width; x++)
+				for (uint32 sW = 0; sW < scaleWidth; sW++, rowDest += bytesPerPixel)
+					memcpy(rowDest, row + x * bytesPerPixel, bytesPerPixel);
 		}
 
-		srcY += fWidth;
+		dest += _surface->pitch;
+
+		for (uint32 sH = 1; sH < scaleHeight; sH++, dest += _surface->pitch)
+			memcpy(dest, dest - _surface->pitch, width * scaleWidth * bytesPerPixel);
+
+		srcY += width;
 
 		if ((y & 3) == 3) {
 			srcU += chromaWidth;
@@ -338,14 +347,15 @@ const Graphics::Surface *Indeo3Decoder::decodeImage(Common::SeekableReadStream *
 				srcUP += chromaWidth;
 				srcVP += chromaWidth;
 			}
-			if (y < (fHeight - 4U)) {
+			if (y < (height - 4U)) {
 				srcUN += chromaWidth;
 				srcVN += chromaWidth;
 			}
 		}
 	}
 
-	return _surface;
+	delete[] row;
+	delete[] terms;
 }
 
 typedef struct {
@@ -506,12 +516,12 @@ void Indeo3Decoder::decodeChunk(byte *cur, byte *ref, int width, int height,
 			cmd = (bit_buf >> bit_pos) & 0x03;
 
 			if (cmd == 0 || ref_vectors != NULL) {
-				for (lp1 = 0; lp1 < blks_width; lp1++) {
-					for (i = 0, j = 0; i < blks_height; i++, j += width_tbl[1])
-						((uint32 *)cur_frm_pos)[j] = ((uint32 *)ref_frm_pos)[j];
-					cur_frm_pos += 4;
-					ref_frm_pos += 4;
-				}
+				// Copy whole rows. When copying from the row above in the
+				// current frame, that row is always complete already.
+				for (i = 0, j = 0; i < blks_height; i++, j += width_tbl[1])
+					memcpy(cur_frm_pos + j * 4, ref_frm_pos + j * 4, blks_width * 4);
+				cur_frm_pos += blks_width * 4;
+				ref_frm_pos += blks_width * 4;
 			} else if (cmd != 1)
 				return;
 		} else {
@@ -77,6 +77,8 @@ private:
 	void buildModPred();
 	void allocFrames();
 
+	void convertToSurface(uint32 width, uint32 height, uint32 chromaWidth);
+
 	void decodeChunk(byte *cur, byte *ref, int width, int height,
 			const byte *buf1, uint32 fflags2, const byte *hdr,
 			const byte *buf2, int min_width_160);
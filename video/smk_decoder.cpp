@@ -283,6 +283,11 @@ SmackerDecoder::SmackerDecoder(Audio::Mixer *mixer, Audio::Mixer::SoundType soun
 	_surface = 0;
 	_fileStream = 0;
 	_dirtyPalette = false;
+	_firstFrameOffset = 0;
+	_seeking = false;
+	_audioBytesRead = 0;
+	_audioSkipBytes = 0;
+	_audioTimeOffset = 0;
 }
 
 SmackerDecoder::~SmackerDecoder() {
@@ -291,7 +296,7 @@ SmackerDecoder::~SmackerDecoder() {
 
 uint32 SmackerDecoder::getElapsedTime() const {
 	if (_audioStream && _audioStarted)
-		return _mixer->getSoundElapsedTime(_audioHandle);
+		return _audioTimeOffset + _mixer->getSoundElapsedTime(_audioHandle);
 
 	return FixedRateVideoDecoder::getElapsedTime();
 }
@@ -398,6 +403,11 @@ bool SmackerDecoder::loadStream(Common::SeekableReadStream *stream) {
 	_FullTree = new BigHuffmanTree(bs, _header.fullSize);
 	_TypeTree = new BigHuffmanTree(bs, _header.typeSize);
 
+	_firstFrameOffset = _fileStream->pos();
+	_audioBytesRead = 0;
+	_audioSkipBytes = 0;
+	_audioTimeOffset = 0;
+
 	_surface = new Graphics::Surface();
 
 	// Height needs to be doubled if we have flags (Y-interlaced or Y-doubled)
@@ -662,14 +672,12 @@ void SmackerDecoder::handleAudioTrack(byte track, uint32 chunkSize, uint32 unpac
 			if (_header.audioInfo[track].isStereo)
 				flags = flags | Audio::FLAG_STEREO;
 
-			_audioStream->queueBuffer(soundBuffer, chunkSize, DisposeAfterUse::YES, flags);
+			queueAudioBuffer(soundBuffer, chunkSize, flags);
 			// The sound buffer will be deleted by QueuingAudioStream
 		}
 
-		if (!_audioStarted) {
-			_mixer->playStream(_soundType, &_audioHandle, _audioStream, -1, 255);
-			_audioStarted = true;
-		}
+		if (!_audioStarted && !_seeking && _audioStream->numQueuedStreams() > 0)
+			startAudio();
 	} else {
 		// Ignore the rest of the audio tracks, if they exist
 		// TODO: Are there any Smacker videos with more than one audio stream?
@@ -764,10 +772,101 @@ void SmackerDecoder::queueCompressedBuffer(byte *buffer, uint32 bufferSize,
 		flags = flags | Audio::FLAG_16BITS;
 	if (_header.audioInfo[0].isStereo)
 		flags = flags | Audio::FLAG_STEREO;
-	_audioStream->queueBuffer(unpackedBuffer, unpackedSize, DisposeAfterUse::YES, flags);
+	queueAudioBuffer(unpackedBuffer, unpackedSize, flags);
 	// unpackedBuffer will be deleted by QueuingAudioStream
 }
 
+void SmackerDecoder::queueAudioBuffer(byte *buffer, uint32 size, byte flags) {
+	_audioBytesRead += size;
+
+	// Drop the audio before the time seeked to
+	if (_audioSkipBytes >= size) {
+		_audioSkipBytes -= size;
+		free(buffer);
+		return;
+	}
+
+	if (_audioSkipBytes > 0) {
+		size -= _audioSkipBytes;
+		memmove(buffer, buffer + _audioSkipBytes, size);
+		_audioSkipBytes = 0;
+	}
+
+	_audioStream->queueBuffer(buffer, size, DisposeAfterUse::YES, flags);
+}
+
+void SmackerDecoder::seekToTime(Audio::Timestamp time) {
+	if (_frameCount == 0)
+		return;
+
+	uint32 frame = MIN<uint32>(getFrameAtTime(time.msecs()), _frameCount - 1);
+	uint32 frameTime = getFrameBeginTime(frame);
+
+	const AudioInfo &audioInfo = _header.audioInfo[0];
+	uint32 audioBytes = 0;
+
+	if (_audioStream) {
+		uint32 sampleSize = (audioInfo.is16Bits ? 2 : 1) * (audioInfo.isStereo ? 2 : 1);
+		audioBytes = (uint32)((double)frameTime * audioInfo.sampleRate / 1000) * sampleSize;
+	}
+
+	// Every frame builds upon the previous one, so go back to the start if
+	// the frame has already been decoded. The same applies if the audio at
+	// the new position has already been queued, as audio usually leads.
+	if ((int32)frame <= _curFrame || audioBytes < _audioBytesRead) {
+		_fileStream->seek(_firstFrameOffset);
+		_curFrame = -1;
+		_audioBytesRead = 0;
+
+		memset(_palette, 0, sizeof(_palette));
+		memset(_surface->pixels, 0, _surface->pitch * _surface->h);
+	}
+
+	if (_audioStream) {
+		if (_audioStarted) {
+			// The mixer will delete the stream.
+			_mixer->stopHandle(_audioHandle);
+			_audioStarted = false;
+		} else {
+			delete _audioStream;
+		}
+
+		_audioStream = Audio::makeQueuingAudioStream(audioInfo.sampleRate, audioInfo.isStereo);
+		_audioSkipBytes = audioBytes - _audioBytesRead;
+		_audioTimeOffset = frameTime;
+	}
+
+	// Decode everything up to the frame before the one seeked to
+	_seeking = true;
+	while (_curFrame < (int32)frame - 1)
+		decodeNextFrame();
+	_seeking = false;
+
+	if (_audioStream && _audioStream->numQueuedStreams() > 0)
+		startAudio();
+
+	_startTime = g_system->getMillis() - frameTime;
+	resetPauseStartTime();
+}
+
+void SmackerDecoder::startAudio() {
+	_mixer->playStream(_soundType, &_audioHandle, _audioStream, -1, 255);
+	_audioStarted = true;
+
+	// Pause the audio again if we're still paused
+	if (isPaused())
+		_mixer->pauseHandle(_audioHandle, true);
+}
+
+void SmackerDecoder::pauseVideoIntern(bool pause) {
+	if (_audioStarted)
+		_mixer->pauseHandle(_audioHandle, pause);
+}
+
+uint32 SmackerDecoder::getDuration() const {
+	return getFrameBeginTime(_frameCount);
+}
+
 void SmackerDecoder::unpackPalette() {
 	uint startPos = _fileStream->pos();
 	uint32 len = 4 * _fileStream->readByte();
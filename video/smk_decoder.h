@@ -56,7 +56,7 @@ class BigHuffmanTree;
  *  - sword2
  *  - toon
  */
-class SmackerDecoder : public FixedRateVideoDecoder {
+class SmackerDecoder : public FixedRateVideoDecoder, public SeekableVideoDecoder {
 public:
 	SmackerDecoder(Audio::Mixer *mixer,
 			Audio::Mixer::SoundType soundType = Audio::Mixer::kSFXSoundType);
@@ -76,8 +76,13 @@ public:
 	bool hasDirtyPalette() const { return _dirtyPalette; }
 	virtual void handleAudioTrack(byte track, uint32 chunkSize, uint32 unpackedSize);
 
+	// SeekableVideoDecoder API
+	void seekToTime(Audio::Timestamp time);
+	uint32 getDuration() const;
+
 protected:
 	Common::Rational getFrameRate() const { return _frameRate; }
+	void pauseVideoIntern(bool pause);
 	Common::SeekableReadStream *_fileStream;
 
 protected:
@@ -85,6 +90,8 @@ protected:
 	// Possible runs of blocks
 	uint getBlockRun(int index) { return (index <= 58) ? index + 1 : 128 << (index - 59); }
 	void queueCompressedBuffer(byte *buffer, uint32 bufferSize, uint32 unpackedSize, int streamNum);
+	void queueAudioBuffer(byte *buffer, uint32 size, byte flags);
+	void startAudio();
 
 	enum AudioCompression {
 		kCompressionNone,
@@ -136,6 +143,14 @@ protected:
 	Audio::QueuingAudioStream *_audioStream;
 	Audio::SoundHandle _audioHandle;
 
+	// Smacker has no key frames, so seeking means decoding all frames in
+	// between. The audio up to the time seeked to is dropped.
+	uint32 _firstFrameOffset; ///< File offset of the first frame
+	bool _seeking;            ///< Decoding the frames before the one seeked to
+	uint32 _audioBytesRead;   ///< Audio data of track 0 decoded so far
+	uint32 _audioSkipBytes;   ///< Audio data still to be dropped
+	uint32 _audioTimeOffset;  ///< Time (in ms) at which the audio stream starts
+
 	BigHuffmanTree *_MMapTree;
 	BigHuffmanTree *_MClrTree;
 	BigHuffmanTree *_FullTree;
@@ -27,6 +27,7 @@
 #include "common/system.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
@@ -115,4 +116,190 @@ uint32 FixedRateVideoDecoder::getFrameBeginTime(uint32 frame) const {
 	return beginTime.toInt();
 }
 
+uint32 FixedRateVideoDecoder::getFrameAtTime(uint32 time) const {
+	uint32 frame = (uint32)(getFrameRate().toDouble() * time / 1000);
+
+	// Make up for rounding differences to getFrameBeginTime()
+	while (frame > 0 && getFrameBeginTime(frame) > time)
+		frame--;
+	while (getFrameBeginTime(frame + 1) <= time)
+		frame++;
+
+	return frame;
+}
+
+BufferedVideoDecoder::BufferedVideoDecoder(VideoDecoder *decoder, uint bufferSize, DisposeAfterUse::Flag disposeAfterUse)
+	: _decoder(decoder), _disposeAfterUse(disposeAfterUse) {
+	assert(_decoder);
+	assert(bufferSize > 0);
+
+	_frameSlots = bufferSize + 1;
+	_frames = new BufferedFrame[_frameSlots];
+	for (uint i = 0; i < _frameSlots; i++)
+		_frames[i].surface = 0;
+
+	_head = 0;
+	_count = 0;
+	_dirtyPalette = false;
+	memset(_palette, 0, sizeof(_palette));
+
+	capturePalette();
+}
+
+BufferedVideoDecoder::~BufferedVideoDecoder() {
+	for (uint i = 0; i < _frameSlots; i++) {
+		if (_frames[i].surface) {
+			_frames[i].surface->free();
+			delete _frames[i].surface;
+		}
+	}
+
+	delete[] _frames;
+
+	if (_disposeAfterUse == DisposeAfterUse::YES)
+		delete _decoder;
+}
+
+bool BufferedVideoDecoder::loadStream(Common::SeekableReadStream *stream) {
+	close();
+
+	if (!_decoder->loadStream(stream))
+		return false;
+
+	capturePalette();
+	return true;
+}
+
+void BufferedVideoDecoder::close() {
+	_decoder->close();
+	clearBuffer();
+	_dirtyPalette = false;
+	reset();
+}
+
+bool BufferedVideoDecoder::isVideoLoaded() const {
+	return _decoder->isVideoLoaded();
+}
+
+uint16 BufferedVideoDecoder::getWidth() const {
+	return _decoder->getWidth();
+}
+
+uint16 BufferedVideoDecoder::getHeight() const {
+	return _decoder->getHeight();
+}
+
+Graphics::PixelFormat BufferedVideoDecoder::getPixelFormat() const {
+	return _decoder->getPixelFormat();
+}
+
+const byte *BufferedVideoDecoder::getPalette() {
+	_dirtyPalette = false;
+	return _palette;
+}
+
+uint32 BufferedVideoDecoder::getFrameCount() const {
+	return _decoder->getFrameCount();
+}
+
+uint32 BufferedVideoDecoder::getElapsedTime() const {
+	return _decoder->getElapsedTime();
+}
+
+uint32 BufferedVideoDecoder::getTimeToNextFrame() const {
+	if (_count == 0)
+		return _decoder->getTimeToNextFrame();
+
+	uint32 dueTime = _frames[_head].dueTime;
+	uint32 curTime = g_system->getMillis();
+
+	return (dueTime > curTime) ? dueTime - curTime : 0;
+}
+
+bool BufferedVideoDecoder::endOfVideo() const {
+	return _count == 0 && _decoder->endOfVideo();
+}
+
+bool BufferedVideoDecoder::decodeAhead() {
+	if (_count == _frameSlots - 1 || _decoder->endOfVideo())
+		return false;
+
+	BufferedFrame &frame = _frames[(_head + _count) % _frameSlots];
+
+	// The time until the frame is due only depends on the wrapped decoder's
+	// clock, so it stays valid no matter how early the frame is decoded
+	frame.dueTime = g_system->getMillis() + _decoder->getTimeToNextFrame();
+
+	const Graphics::Surface *surface = _decoder->decodeNextFrame();
+	frame.frameNum = _decoder->getCurFrame();
+
+	if (surface) {
+		if (!frame.surface)
+			frame.surface = new Graphics::Surface();
+
+		if (frame.surface->w != surface->w || frame.surface->h != surface->h || frame.surface->format != surface->format)
+			frame.surface->create(surface->w, surface->h, surface->format);
+
+		const byte *src = (const byte *)surface->pixels;
+		byte *dst = (byte *)frame.surface->pixels;
+		const uint rowSize = surface->w * surface->format.bytesPerPixel;
+
+		for (int y = 0; y < surface->h; y++) {
+			memcpy(dst, src, rowSize);
+			src += surface->pitch;
+			dst += frame.surface->pitch;
+		}
+	} else if (frame.surface) {
+		frame.surface->free();
+		delete frame.surface;
+		frame.surface = 0;
+	}
+
+	frame.dirtyPalette = _decoder->hasDirtyPalette();
+	if (frame.dirtyPalette)
+		memcpy(frame.palette, _decoder->getPalette(), sizeof(frame.palette));
+
+	_count++;
+	return true;
+}
+
+const Graphics::Surface *BufferedVideoDecoder::decodeNextFrame() {
+	if (_count == 0 && !decodeAhead())
+		return 0;
+
+	const BufferedFrame &frame = _frames[_head];
+	_head = (_head + 1) % _frameSlots;
+	_count--;
+
+	_curFrame = frame.frameNum;
+
+	if (frame.dirtyPalette) {
+		memcpy(_palette, frame.palette, sizeof(_palette));
+		_dirtyPalette = true;
+	}
+
+	return frame.surface;
+}
+
+void BufferedVideoDecoder::pauseVideoIntern(bool pause) {
+	_decoder->pauseVideo(pause);
+}
+
+void BufferedVideoDecoder::addPauseTime(uint32 ms) {
+	for (uint i = 0; i < _count; i++)
+		_frames[(_head + i) % _frameSlots].dueTime += ms;
+}
+
+void BufferedVideoDecoder::clearBuffer() {
+	_head = 0;
+	_count = 0;
+}
+
+void BufferedVideoDecoder::capturePalette() {
+	if (_decoder->isVideoLoaded() && _decoder->hasDirtyPalette()) {
+		memcpy(_palette, _decoder->getPalette(), sizeof(_palette));
+		_dirtyPalette = true;
+	}
+}
+
 } // End of namespace Video
@@ -24,6 +24,7 @@
 #define VIDEO_DECODER_H
 
 #include "common/str.h"
+#include "common/types.h"
 
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 
@@ -225,8 +226,15 @@ protected:
 	 */
 	virtual Common::Rational getFrameRate() const = 0;
 
-private:
+	/**
+	 * Return the time (in ms) at which the given frame should be shown.
+	 */
 	uint32 getFrameBeginTime(uint32 frame) const;
+
+	/**
+	 * Return the frame that should be showing at the given time (in ms).
+	 */
+	uint32 getFrameAtTime(uint32 time) const;
 };
 
 /**
@@ -271,6 +279,92 @@ public:
 	virtual uint32 getDuration() const = 0;
 };
 
+/**
+ * A VideoDecoder wrapper that decodes the frames of another decoder ahead of
+ * time into a small ring of surfaces, and hands them out at the time they are
+ * due. The expensive decoding work can thus be done whenever the caller has
+ * time to spare, by calling decodeAhead() instead of sleeping, so that single
+ * slow frames no longer make playback fall behind.
+ *
+ * Decoding ahead is not done on a separate thread: decodeNextFrame() of the
+ * wrapped decoders changes their stream position, frame counter, palette
+ * and dirty palette flag, which the wrapper forwards to its caller through
+ * endOfVideo(), getPalette() and friends. None of the decoders lock that
+ * state, and adding locks to each of them is not worth it for a wrapper
+ * whose idle time decoding already keeps playback on time.
+ *
+ * The wrapped decoder must not be used directly while it is wrapped.
+ */
+class BufferedVideoDecoder : public VideoDecoder {
+public:
+	/**
+	 * Create a wrapper for the given decoder. The decoder may already have
+	 * a video loaded.
+	 * @param decoder			the decoder to wrap
+	 * @param bufferSize		the maximum number of frames to decode ahead
+	 * @param disposeAfterUse	whether to delete the decoder along with the wrapper
+	 */
+	BufferedVideoDecoder(VideoDecoder *decoder, uint bufferSize = 4, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+	~BufferedVideoDecoder();
+
+	bool loadStream(Common::SeekableReadStream *stream);
+	void close();
+	bool isVideoLoaded() const;
+
+	uint16 getWidth() const;
+	uint16 getHeight() const;
+	Graphics::PixelFormat getPixelFormat() const;
+	const byte *getPalette();
+	bool hasDirtyPalette() const { return _dirtyPalette; }
+
+	uint32 getFrameCount() const;
+	uint32 getElapsedTime() const;
+	uint32 getTimeToNextFrame() const;
+	const Graphics::Surface *decodeNextFrame();
+	bool endOfVideo() const;
+
+	/**
+	 * Decode one more frame into the buffer, unless it is full or the
+	 * video has been decoded completely.
+	 * @return whether a frame was decoded
+	 */
+	bool decodeAhead();
+
+	/**
+	 * Returns the number of frames decoded but not handed out yet.
+	 */
+	uint getBufferedFrameCount() const { return _count; }
+
+protected:
+	void pauseVideoIntern(bool pause);
+	void addPauseTime(uint32 ms);
+
+private:
+	struct BufferedFrame {
+		Graphics::Surface *surface;	///< 0 if the decoder returned no frame
+		int32 frameNum;
+		uint32 dueTime;	///< in OSystem::getMillis() time
+		bool dirtyPalette;
+		byte palette[256 * 3];
+	};
+
+	void clearBuffer();
+	void capturePalette();
+
+	VideoDecoder *_decoder;
+	DisposeAfterUse::Flag _disposeAfterUse;
+
+	// Ring of bufferSize + 1 frames: the queued frames, followed by the
+	// one handed out last, which the caller may still be using.
+	BufferedFrame *_frames;
+	uint _frameSlots;
+	uint _head;
+	uint _count;
+
+	byte _palette[256 * 3];
+	bool _dirtyPalette;
+};
+
 } // End of namespace Video
 
 #endif